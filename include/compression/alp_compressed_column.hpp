@@ -0,0 +1,250 @@
+#pragma once
+
+#include "bit_packing.hpp"
+#include "block_compressed_column.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace CoGaDB
+{
+
+    /*!
+     *  \brief     This class represents the coding of blocks of a 32 bit floating point type T that mostly holds
+     * decimals in the style of ALP (adaptive lossless floating point compression).
+     *  \details   For every block the encoder searches the exponent e for which most rows v become an integer
+     * k = round(v * 10^e) that decodes back to exactly v as float(k / 10^e). These integers are stored with
+     * frame-of-reference bit-packing, rows that do not round trip (too many decimals, -0.0, NaN, ...) are stored as
+     * exceptions next to their position in the block. Decoding is an integer unpack followed by a conversion and a
+     * division per row. Since decoding is monotone in k, predicates are evaluated as a range check on the packed
+     * integers against bounds derived from the comparison value once per block.
+     */
+    template <class T>
+    struct ALPCodec
+    {
+        static_assert(std::is_floating_point_v<T> && sizeof(T) == sizeof(uint32_t),
+                      "ALP coding is implemented for 32 bit floating point values");
+
+        static constexpr size_t BLOCK_SIZE = bit_packing::SIMD_BLOCK_SIZE;
+
+        // largest exponent that is tried, floats carry less than 10 significant decimal digits
+        static constexpr uint8_t MAX_EXPONENT = 10;
+
+        static constexpr std::array<double, MAX_EXPONENT + 1> POWERS_OF_TEN{1e0, 1e1, 1e2, 1e3, 1e4, 1e5,
+                                                                            1e6, 1e7, 1e8, 1e9, 1e10};
+
+        struct Block
+        {
+            uint8_t exponent = 0;                     // rows are stored as k = round(row * 10^exponent)
+            int32_t base = 0;                         // minimum k of the block
+            uint8_t bit_width = 0;                    // bits per packed offset k - base
+            std::vector<uint32_t> packed;             // BLOCK_SIZE offsets in the layout of pack128
+            std::vector<uint8_t> exception_positions; // ascending positions of the rows that are stored as they are
+            std::vector<T> exception_values;          // value of every exception
+
+            template <class Archive>
+            void serialize(Archive &archive)
+            {
+                archive(exponent, base, bit_width, packed, exception_positions, exception_values);
+            }
+        };
+
+        static Block encodeBlock(const T *values);
+
+        static void decodeBlock(const Block &block, T *values);
+
+        static T decodeRow(const Block &block, size_t i);
+
+        static size_t sizeInBytes(const Block &block);
+
+        // the row that the integer k decodes to with the given exponent
+        static T decodeValue(int64_t k, uint8_t exponent);
+
+        // stores the integer of value to k and returns true if value round trips with the given exponent
+        static bool encodeValue(T value, uint8_t exponent, int64_t &k);
+
+        // smallest k that decodes to a row that is not less than value (strict = false) or greater than value
+        // (strict = true)
+        static int64_t lowerBound(T value, uint8_t exponent, bool strict);
+
+        // evaluates (row comp value) on all rows of block, appends the qualifying TIDs to result_tids unless it is a
+        // nullptr and returns the number of qualifying rows
+        static size_t scanBlock(const Block &block, T value, ValueComparator comp, TID first_tid,
+                                PositionList *result_tids);
+    };
+
+    /*!
+     *  \brief     This class represents an ALP compressed column with a 32 bit floating point type T.
+     */
+    template <class T>
+    using ALPCompressedColumn = BlockCompressedColumn<T, ALPCodec<T>>;
+
+    /***************** Start of Implementation Section ******************/
+
+    template <class T>
+    T ALPCodec<T>::decodeValue(const int64_t k, const uint8_t exponent)
+    {
+        return static_cast<T>(static_cast<double>(k) / POWERS_OF_TEN[exponent]);
+    }
+
+    template <class T>
+    bool ALPCodec<T>::encodeValue(const T value, const uint8_t exponent, int64_t &k)
+    {
+        double scaled = std::round(static_cast<double>(value) * POWERS_OF_TEN[exponent]);
+        if (!(std::abs(scaled) <= std::numeric_limits<int32_t>::max()))
+            return false;
+        k = static_cast<int64_t>(scaled);
+
+        // the bits have to match, -0.0 would come back as 0.0
+        T decoded = decodeValue(k, exponent);
+        return std::memcmp(&decoded, &value, sizeof(T)) == 0;
+    }
+
+    template <class T>
+    typename ALPCodec<T>::Block ALPCodec<T>::encodeBlock(const T *values)
+    {
+        Block block;
+
+        size_t best_conforming = 0;
+        int64_t k;
+        for (uint8_t exponent = 0; exponent <= MAX_EXPONENT && best_conforming < BLOCK_SIZE; ++exponent)
+        {
+            size_t conforming = 0;
+            for (size_t i = 0; i < BLOCK_SIZE; ++i)
+                conforming += encodeValue(values[i], exponent, k);
+            if (conforming > best_conforming)
+            {
+                block.exponent = exponent;
+                best_conforming = conforming;
+            }
+        }
+
+        std::array<int64_t, BLOCK_SIZE> integers;
+        std::array<bool, BLOCK_SIZE> conforms;
+        int64_t base = std::numeric_limits<int32_t>::max();
+        for (size_t i = 0; i < BLOCK_SIZE; ++i)
+        {
+            conforms[i] = encodeValue(values[i], block.exponent, integers[i]);
+            if (conforms[i])
+                base = std::min(base, integers[i]);
+        }
+        block.base = static_cast<int32_t>(base);
+
+        // exceptions keep offset 0 in the packed integers, so they do not widen the block
+        std::array<uint32_t, BLOCK_SIZE> offsets;
+        uint32_t all_bits = 0;
+        for (size_t i = 0; i < BLOCK_SIZE; ++i)
+        {
+            offsets[i] = conforms[i] ? static_cast<uint32_t>(integers[i] - base) : 0;
+            all_bits |= offsets[i];
+            if (!conforms[i])
+            {
+                block.exception_positions.push_back(static_cast<uint8_t>(i));
+                block.exception_values.push_back(values[i]);
+            }
+        }
+
+        block.bit_width = static_cast<uint8_t>(bit_packing::required_bit_width(all_bits));
+        block.packed.resize(bit_packing::packed_size128(block.bit_width));
+        bit_packing::pack128(offsets.data(), block.bit_width, block.packed.data());
+        return block;
+    }
+
+    template <class T>
+    void ALPCodec<T>::decodeBlock(const Block &block, T *values)
+    {
+        std::array<uint32_t, BLOCK_SIZE> offsets;
+        bit_packing::unpack128(block.packed.data(), block.bit_width, offsets.data());
+
+        const double divisor = POWERS_OF_TEN[block.exponent];
+        for (size_t i = 0; i < BLOCK_SIZE; ++i)
+            values[i] = static_cast<T>(static_cast<double>(int64_t(block.base) + offsets[i]) / divisor);
+        for (size_t i = 0; i < block.exception_positions.size(); ++i)
+            values[block.exception_positions[i]] = block.exception_values[i];
+    }
+
+    template <class T>
+    int64_t ALPCodec<T>::lowerBound(const T value, const uint8_t exponent, const bool strict)
+    {
+        // all integers of a block lie in the int32 range, so the bound can be clamped to one step outside of it
+        constexpr double lowest = double(std::numeric_limits<int32_t>::min()) - 1;
+        constexpr double highest = double(std::numeric_limits<int32_t>::max()) + 1;
+        double estimate = std::floor(static_cast<double>(value) * POWERS_OF_TEN[exponent]);
+        int64_t k = static_cast<int64_t>(std::clamp(estimate, lowest, highest));
+
+        // the estimate is off by at most a rounding step, decodeValue is monotone in k
+        auto qualifies = [&](int64_t candidate) {
+            T decoded = decodeValue(candidate, exponent);
+            return strict ? decoded > value : decoded >= value;
+        };
+        while (k > static_cast<int64_t>(lowest) && qualifies(k - 1))
+            --k;
+        while (k < static_cast<int64_t>(highest) && !qualifies(k))
+            ++k;
+        return k;
+    }
+
+    template <class T>
+    size_t ALPCodec<T>::scanBlock(const Block &block, const T value, const ValueComparator comp, const TID first_tid,
+                                  PositionList *result_tids)
+    {
+        std::array<uint8_t, BLOCK_SIZE> matches{};
+        if (!std::isnan(value))
+        {
+            // the qualifying integers form the range [from, to)
+            int64_t from = std::numeric_limits<int64_t>::min(), to = std::numeric_limits<int64_t>::max();
+            if (comp == LESSER || comp == EQUAL)
+                (comp == LESSER ? to : from) = lowerBound(value, block.exponent, false);
+            if (comp == GREATER || comp == EQUAL)
+                (comp == GREATER ? from : to) = lowerBound(value, block.exponent, true);
+
+            std::array<uint32_t, BLOCK_SIZE> offsets;
+            bit_packing::unpack128(block.packed.data(), block.bit_width, offsets.data());
+            for (size_t i = 0; i < BLOCK_SIZE; ++i)
+            {
+                int64_t k = int64_t(block.base) + offsets[i];
+                matches[i] = (k >= from) & (k < to);
+            }
+        }
+
+        for (size_t i = 0; i < block.exception_positions.size(); ++i)
+        {
+            const T &exception = block.exception_values[i];
+            matches[block.exception_positions[i]] = (comp == EQUAL && exception == value) ||
+                                                    (comp == LESSER && exception < value) ||
+                                                    (comp == GREATER && exception > value);
+        }
+
+        size_t qualifying_rows = 0;
+        for (size_t i = 0; i < BLOCK_SIZE; ++i)
+        {
+            if (matches[i] && result_tids)
+                result_tids->push_back(first_tid + static_cast<TID>(i));
+            qualifying_rows += matches[i];
+        }
+        return qualifying_rows;
+    }
+
+    template <class T>
+    T ALPCodec<T>::decodeRow(const Block &block, size_t i)
+    {
+        auto exception = std::lower_bound(block.exception_positions.begin(), block.exception_positions.end(), i);
+        if (exception != block.exception_positions.end() && *exception == i)
+            return block.exception_values[exception - block.exception_positions.begin()];
+
+        uint32_t offset = bit_packing::extract128(block.packed.data(), block.bit_width, i);
+        return decodeValue(int64_t(block.base) + offset, block.exponent);
+    }
+
+    template <class T>
+    size_t ALPCodec<T>::sizeInBytes(const Block &block)
+    {
+        return sizeof(block.exponent) + sizeof(block.base) + sizeof(block.bit_width) +
+               block.packed.size() * sizeof(uint32_t) + block.exception_positions.size() * (sizeof(uint8_t) + sizeof(T));
+    }
+
+    /***************** End of Implementation Section ******************/
+
+} // namespace CoGaDB
@@ -0,0 +1,239 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*! \brief Helpers to store unsigned integers with a fixed number of bits per value.
+ *  \details pack() and unpack() pack the values horizontally: value i occupies the bits [i * bit_width, (i + 1) *
+ * bit_width) of the output words and may span two consecutive words. pack128() and unpack128() use a vertical layout
+ * for blocks of 128 32 bit values instead, which lets them process four values per SIMD instruction.*/
+namespace CoGaDB::bit_packing
+{
+
+    /*! \brief number of bits that are needed to represent value */
+    template <class U>
+    inline unsigned required_bit_width(U value)
+    {
+        static_assert(std::is_unsigned_v<U>, "bit packing works on unsigned integers");
+        unsigned bit_width = 0;
+        for (; value != 0; value >>= 1)
+            ++bit_width;
+        return bit_width;
+    }
+
+    /*! \brief number of words that n packed values with bit_width bits each occupy */
+    template <class U>
+    constexpr size_t packed_size(size_t n, unsigned bit_width)
+    {
+        constexpr size_t word_bits = sizeof(U) * 8;
+        return (n * bit_width + word_bits - 1) / word_bits;
+    }
+
+    /*! \brief maps a signed difference (stored as unsigned two's complement) to an unsigned value, small magnitudes to
+     * small numbers: 0, -1, 1, -2, 2, ... become 0, 1, 2, 3, 4, ...*/
+    template <class U>
+    constexpr U zigzag_encode(U value)
+    {
+        constexpr unsigned word_bits = sizeof(U) * 8;
+        return static_cast<U>(value << 1) ^ static_cast<U>(U(0) - (value >> (word_bits - 1)));
+    }
+
+    template <class U>
+    constexpr U zigzag_decode(U value)
+    {
+        return static_cast<U>(value >> 1) ^ static_cast<U>(U(0) - (value & 1));
+    }
+
+    /*! \brief packs n values with bit_width bits each into packed_size<U>(n, bit_width) words */
+    template <class U>
+    inline void pack(const U *in, size_t n, unsigned bit_width, U *out)
+    {
+        constexpr size_t word_bits = sizeof(U) * 8;
+        std::fill(out, out + packed_size<U>(n, bit_width), U(0));
+        if (bit_width == 0)
+            return;
+
+        for (size_t i = 0, bit = 0; i < n; ++i, bit += bit_width)
+        {
+            size_t word = bit / word_bits, offset = bit % word_bits;
+            out[word] |= static_cast<U>(in[i] << offset);
+            if (offset + bit_width > word_bits)
+                out[word + 1] |= static_cast<U>(in[i] >> (word_bits - offset));
+        }
+    }
+
+    /*! \brief unpacks n values with bit_width bits each */
+    template <class U>
+    inline void unpack(const U *in, size_t n, unsigned bit_width, U *out)
+    {
+        constexpr size_t word_bits = sizeof(U) * 8;
+        if (bit_width == 0)
+        {
+            std::fill(out, out + n, U(0));
+            return;
+        }
+
+        const U mask = bit_width == word_bits ? static_cast<U>(~U(0)) : static_cast<U>((U(1) << bit_width) - 1);
+        for (size_t i = 0, bit = 0; i < n; ++i, bit += bit_width)
+        {
+            size_t word = bit / word_bits, offset = bit % word_bits;
+            U value = static_cast<U>(in[word] >> offset);
+            if (offset + bit_width > word_bits)
+                value |= static_cast<U>(in[word + 1] << (word_bits - offset));
+            out[i] = value & mask;
+        }
+    }
+
+    /*! \brief extracts value i of values packed with pack() without unpacking the others */
+    template <class U>
+    inline U extract(const U *in, unsigned bit_width, size_t i)
+    {
+        constexpr size_t word_bits = sizeof(U) * 8;
+        if (bit_width == 0)
+            return 0;
+
+        const U mask = bit_width == word_bits ? static_cast<U>(~U(0)) : static_cast<U>((U(1) << bit_width) - 1);
+        size_t bit = i * bit_width, word = bit / word_bits, offset = bit % word_bits;
+        U value = static_cast<U>(in[word] >> offset);
+        if (offset + bit_width > word_bits)
+            value |= static_cast<U>(in[word + 1] << (word_bits - offset));
+        return value & mask;
+    }
+
+    /*! \brief number of values in a block of the vertical layout */
+    constexpr size_t SIMD_BLOCK_SIZE = 128;
+
+    /*! \brief number of 32 bit words a block of the vertical layout with bit_width bits per value occupies */
+    constexpr size_t packed_size128(unsigned bit_width)
+    {
+        return 4 * bit_width;
+    }
+
+    /*! \brief packs a block of 128 values into 4 * bit_width words, only the lowest bit_width bits of every value are kept
+     *  \details Value i belongs to lane i % 4. Every lane packs its 32 values horizontally, and word k of lane l is
+     * stored at out[4 * k + l], so one register holds word k of all four lanes.*/
+    inline void pack128(const uint32_t *in, unsigned bit_width, uint32_t *out)
+    {
+        if (bit_width == 0)
+            return;
+        const uint32_t mask = bit_width == 32 ? ~uint32_t(0) : (uint32_t(1) << bit_width) - 1;
+
+#if defined(__SSE2__)
+        const __m128i value_mask = _mm_set1_epi32(static_cast<int>(mask));
+        __m128i word = _mm_setzero_si128();
+        unsigned shift = 0;
+        for (size_t j = 0; j < SIMD_BLOCK_SIZE / 4; ++j)
+        {
+            __m128i values = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + 4 * j)), value_mask);
+            word = _mm_or_si128(word, _mm_sll_epi32(values, _mm_cvtsi32_si128(static_cast<int>(shift))));
+            shift += bit_width;
+            if (shift >= 32)
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(out), word);
+                out += 4;
+                shift -= 32;
+                // the bits of the current values that did not fit into the stored word
+                word = shift == 0 ? _mm_setzero_si128()
+                                  : _mm_srl_epi32(values, _mm_cvtsi32_si128(static_cast<int>(bit_width - shift)));
+            }
+        }
+#else
+        for (size_t lane = 0; lane < 4; ++lane)
+        {
+            uint32_t word = 0;
+            unsigned shift = 0;
+            uint32_t *lane_out = out + lane;
+            for (size_t j = 0; j < SIMD_BLOCK_SIZE / 4; ++j)
+            {
+                uint32_t value = in[4 * j + lane] & mask;
+                word |= value << shift;
+                shift += bit_width;
+                if (shift >= 32)
+                {
+                    *lane_out = word;
+                    lane_out += 4;
+                    shift -= 32;
+                    word = shift == 0 ? 0 : value >> (bit_width - shift);
+                }
+            }
+        }
+#endif
+    }
+
+    /*! \brief unpacks a block of 128 values that was packed with pack128 */
+    inline void unpack128(const uint32_t *in, unsigned bit_width, uint32_t *out)
+    {
+        if (bit_width == 0)
+        {
+            std::fill(out, out + SIMD_BLOCK_SIZE, uint32_t(0));
+            return;
+        }
+        const uint32_t mask = bit_width == 32 ? ~uint32_t(0) : (uint32_t(1) << bit_width) - 1;
+        const uint32_t *end = in + packed_size128(bit_width);
+
+#if defined(__SSE2__)
+        const __m128i value_mask = _mm_set1_epi32(static_cast<int>(mask));
+        __m128i word = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+        unsigned shift = 0;
+        for (size_t j = 0; j < SIMD_BLOCK_SIZE / 4; ++j)
+        {
+            __m128i values = _mm_srl_epi32(word, _mm_cvtsi32_si128(static_cast<int>(shift)));
+            shift += bit_width;
+            if (shift >= 32)
+            {
+                in += 4;
+                shift -= 32;
+                if (in < end)
+                {
+                    word = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+                    // the remaining bits of the values continue in the next word
+                    if (shift > 0)
+                        values = _mm_or_si128(values, _mm_sll_epi32(word, _mm_cvtsi32_si128(static_cast<int>(bit_width - shift))));
+                }
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 4 * j), _mm_and_si128(values, value_mask));
+        }
+#else
+        for (size_t lane = 0; lane < 4; ++lane)
+        {
+            const uint32_t *lane_in = in + lane;
+            unsigned shift = 0;
+            for (size_t j = 0; j < SIMD_BLOCK_SIZE / 4; ++j)
+            {
+                uint32_t value = shift >= 32 ? 0 : *lane_in >> shift;
+                shift += bit_width;
+                if (shift >= 32)
+                {
+                    lane_in += 4;
+                    shift -= 32;
+                    if (shift > 0 && lane_in < end)
+                        value |= *lane_in << (bit_width - shift);
+                }
+                out[4 * j + lane] = value & mask;
+            }
+        }
+#endif
+    }
+
+    /*! \brief extracts value i of a block that was packed with pack128 without unpacking the whole block */
+    inline uint32_t extract128(const uint32_t *in, unsigned bit_width, size_t i)
+    {
+        if (bit_width == 0)
+            return 0;
+        const uint32_t mask = bit_width == 32 ? ~uint32_t(0) : (uint32_t(1) << bit_width) - 1;
+
+        size_t lane = i % 4, bit = (i / 4) * bit_width;
+        size_t word = bit / 32, offset = bit % 32;
+        uint32_t value = in[4 * word + lane] >> offset;
+        if (offset + bit_width > 32)
+            value |= in[4 * (word + 1) + lane] << (32 - offset);
+        return value & mask;
+    }
+
+} // namespace CoGaDB::bit_packing
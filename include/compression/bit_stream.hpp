@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*! \brief Helpers to write and read variable length bit fields to and from a vector of 64 bit words.
+ *  \details Fields are stored least significant bit first: the first bit written is bit 0 of word 0.*/
+namespace CoGaDB::bit_stream
+{
+
+    inline unsigned count_leading_zeros(uint32_t word)
+    {
+        if (word == 0)
+            return 32;
+#if defined(__GNUC__)
+        return static_cast<unsigned>(__builtin_clz(word));
+#else
+        unsigned count = 0;
+        for (; (word & 0x80000000u) == 0; word <<= 1)
+            ++count;
+        return count;
+#endif
+    }
+
+    inline unsigned count_trailing_zeros(uint32_t word)
+    {
+        if (word == 0)
+            return 32;
+#if defined(__GNUC__)
+        return static_cast<unsigned>(__builtin_ctz(word));
+#else
+        unsigned count = 0;
+        for (; (word & 1) == 0; word >>= 1)
+            ++count;
+        return count;
+#endif
+    }
+
+    /*! \brief appends bit fields to a vector of words */
+    class BitWriter
+    {
+    public:
+        explicit BitWriter(std::vector<uint64_t> &words) : words_(words), bit_(words.size() * 64) {}
+
+        /*! \brief appends the lowest number_of_bits (at most 32) bits of value */
+        void write(uint32_t value, unsigned number_of_bits)
+        {
+            if (number_of_bits == 0)
+                return;
+            uint64_t field = number_of_bits == 32 ? value : value & ((uint32_t(1) << number_of_bits) - 1);
+
+            size_t word = bit_ / 64, offset = bit_ % 64;
+            if (word == words_.size())
+                words_.push_back(0);
+            words_[word] |= field << offset;
+            if (offset + number_of_bits > 64)
+                words_.push_back(field >> (64 - offset));
+            bit_ += number_of_bits;
+        }
+
+    private:
+        std::vector<uint64_t> &words_;
+        size_t bit_; // number of bits written so far, the vector is assumed to be filled completely before
+    };
+
+    /*! \brief reads bit fields in the order a BitWriter appended them */
+    class BitReader
+    {
+    public:
+        explicit BitReader(const std::vector<uint64_t> &words) : words_(words), bit_(0) {}
+
+        /*! \brief reads the next number_of_bits (at most 32) bits */
+        uint32_t read(unsigned number_of_bits)
+        {
+            if (number_of_bits == 0)
+                return 0;
+
+            size_t word = bit_ / 64, offset = bit_ % 64;
+            uint64_t field = words_[word] >> offset;
+            if (offset + number_of_bits > 64)
+                field |= words_[word + 1] << (64 - offset);
+            bit_ += number_of_bits;
+            return static_cast<uint32_t>(number_of_bits == 32 ? field : field & ((uint64_t(1) << number_of_bits) - 1));
+        }
+
+    private:
+        const std::vector<uint64_t> &words_;
+        size_t bit_; // position of the next bit to read
+    };
+
+} // namespace CoGaDB::bit_stream
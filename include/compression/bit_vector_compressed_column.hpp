@@ -0,0 +1,324 @@
+#pragma once
+
+#include "bitmap.hpp"
+#include "compressed_column.hpp"
+#include "core/global_definitions.hpp"
+#include <cereal/archives/portable_binary.hpp>
+#include <cereal/types/string.hpp>
+#include <cereal/types/vector.hpp>
+#include <iterator>
+#include <sstream>
+
+namespace CoGaDB
+{
+
+    /*!
+     *  \brief     This class represents a bit-vector encoded column with type T.
+     *  \details   For every distinct value the column keeps a bitmap with one bit per row, which is set if the row holds
+     * the value. Filters become bitmap operations: an equality selection converts a single bitmap into a PositionList,
+     * a range selection ORs the bitmaps of all qualifying values, and COUNT is a popcount. The encoding is meant for
+     * columns with few distinct values.
+     */
+    template <class T>
+    class BitVectorCompressedColumn final : public CompressedColumn<T>
+    {
+    public:
+        /***************** constructors and destructor *****************/
+        explicit BitVectorCompressedColumn(const std::string &name);
+
+        ~BitVectorCompressedColumn() final;
+
+        void insert(const ColumnType &new_Value) final;
+
+        void insert(const T &new_value) final;
+
+        template <typename InputIterator>
+        void insert(InputIterator first, InputIterator last);
+
+        void update(TID tid, const ColumnType &new_value) final;
+
+        void update(PositionList &tid, const ColumnType &new_value) final;
+
+        void remove(TID tid) final;
+
+        // assumes tid list is sorted ascending
+        void remove(PositionList &tid) final;
+
+        void clearContent() final;
+
+        ColumnType get(TID tid) final;
+
+        std::string print() const noexcept final;
+
+        [[nodiscard]] size_t size() const noexcept final;
+
+        [[nodiscard]] size_t getSizeInBytes() const noexcept final;
+
+        [[nodiscard]] std::unique_ptr<ColumnBase> copy() const final;
+
+        void store(const std::string &path) final;
+        void load(const std::string &path) final;
+
+        T operator[](int idx) final;
+
+        /*! \brief converts the bitmap of the value (EQUAL) or the OR of the bitmaps of all qualifying values
+         * (LESSER, GREATER) into a PositionList */
+        PositionList selection(const ColumnType &value_for_comparison, ValueComparator comp) final;
+
+        /*! \brief popcount of the bitmaps of all qualifying values */
+        size_t count(const ColumnType &value_for_comparison,
+                     ValueComparator comp,
+                     unsigned int number_of_threads = 1) final;
+
+        /**
+         * @brief Serialization method called by Cereal. Implement this method in your compressed columns to get serialization working.
+         */
+        template <class Archive>
+        void serialize(Archive &archive)
+        {
+            archive(dictionary, bitmaps, number_of_rows);
+        }
+
+    private:
+        std::vector<T> dictionary;                         // distinct values of the column
+        std::vector<std::vector<bitmap::Word>> bitmaps;   // bitmap of every distinct value
+        uint64_t number_of_rows;
+
+        // index of value in dictionary, adds the value with an empty bitmap if it is new
+        size_t lookupOrAdd(const T &value);
+
+        // index of the value that row tid holds
+        size_t valueOf(TID tid) const;
+
+        // indices of all dictionary values v with (v comp value)
+        std::vector<size_t> qualifyingValues(const ColumnType &value_for_comparison, ValueComparator comp) const;
+    };
+
+    /***************** Start of Implementation Section ******************/
+
+    template <class T>
+    BitVectorCompressedColumn<T>::BitVectorCompressedColumn(const std::string &name)
+        : CompressedColumn<T>(name), dictionary(), bitmaps(), number_of_rows(0) {}
+
+    template <class T>
+    BitVectorCompressedColumn<T>::~BitVectorCompressedColumn() = default;
+
+    template <class T>
+    size_t BitVectorCompressedColumn<T>::lookupOrAdd(const T &value)
+    {
+        for (size_t i = 0; i < dictionary.size(); i++)
+        {
+            if (dictionary[i] == value)
+                return i;
+        }
+
+        dictionary.push_back(value);
+        bitmaps.emplace_back(bitmap::words_for(number_of_rows), 0);
+        return dictionary.size() - 1;
+    }
+
+    template <class T>
+    size_t BitVectorCompressedColumn<T>::valueOf(TID tid) const
+    {
+        for (size_t i = 0; i < bitmaps.size(); i++)
+        {
+            if (bitmap::test(bitmaps[i], tid))
+                return i;
+        }
+        return dictionary.size();
+    }
+
+    template <class T>
+    std::vector<size_t> BitVectorCompressedColumn<T>::qualifyingValues(const ColumnType &value_for_comparison,
+                                                                       const ValueComparator comp) const
+    {
+        T value = std::get<T>(value_for_comparison);
+
+        std::vector<size_t> qualifying;
+        for (size_t i = 0; i < dictionary.size(); i++)
+        {
+            if ((comp == EQUAL && dictionary[i] == value) || (comp == LESSER && dictionary[i] < value) ||
+                (comp == GREATER && dictionary[i] > value))
+                qualifying.push_back(i);
+        }
+        return qualifying;
+    }
+
+    template <class T>
+    void BitVectorCompressedColumn<T>::insert(const ColumnType &new_value)
+    {
+        insert(std::get<T>(new_value));
+    }
+
+    template <class T>
+    void BitVectorCompressedColumn<T>::insert(const T &new_value)
+    {
+        size_t value_index = lookupOrAdd(new_value);
+
+        // every bitmap grows by a word when the new row starts a new word
+        if (number_of_rows % bitmap::WORD_BITS == 0)
+        {
+            for (auto &bits : bitmaps)
+                bits.push_back(0);
+        }
+
+        bitmap::set(bitmaps[value_index], number_of_rows);
+        number_of_rows++;
+    }
+
+    template <typename T>
+    template <typename InputIterator>
+    void BitVectorCompressedColumn<T>::insert(InputIterator first, InputIterator last)
+    {
+        for (InputIterator i = first; i < last; ++i)
+        {
+            insert(*i);
+        }
+    }
+
+    template <class T>
+    void BitVectorCompressedColumn<T>::update(TID tid, const ColumnType &new_value)
+    {
+        const T &value = std::get<T>(new_value);
+
+        bitmap::clear(bitmaps[valueOf(tid)], tid);
+        bitmap::set(bitmaps[lookupOrAdd(value)], tid);
+    }
+
+    template <class T>
+    void BitVectorCompressedColumn<T>::update(PositionList &positions, const ColumnType &new_value)
+    {
+        for (auto &tid : positions)
+        {
+            update(tid, new_value);
+        }
+    }
+
+    template <class T>
+    void BitVectorCompressedColumn<T>::remove(TID tid)
+    {
+        for (auto &bits : bitmaps)
+            bitmap::erase(bits, tid, number_of_rows);
+        number_of_rows--;
+    }
+
+    template <class T>
+    void BitVectorCompressedColumn<T>::remove(PositionList &positions)
+    {
+        for (auto rit = positions.rbegin(); rit != positions.rend(); ++rit)
+        {
+            remove(*rit);
+        }
+    }
+
+    template <class T>
+    void BitVectorCompressedColumn<T>::clearContent()
+    {
+        dictionary.clear();
+        bitmaps.clear();
+        number_of_rows = 0;
+    }
+
+    template <class T>
+    ColumnType BitVectorCompressedColumn<T>::get(TID tid)
+    {
+        return {operator[](tid)};
+    }
+
+    template <class T>
+    std::string BitVectorCompressedColumn<T>::print() const noexcept
+    {
+        std::stringstream output;
+
+        output << this->name_ << "(" << size() << ")" << std::endl;
+        for (TID tid = 0; tid < number_of_rows; tid++)
+        {
+            output << "\t" << dictionary[valueOf(tid)] << std::endl;
+        }
+
+        return output.str();
+    }
+
+    template <class T>
+    size_t BitVectorCompressedColumn<T>::size() const noexcept
+    {
+        return number_of_rows;
+    }
+
+    template <class T>
+    size_t BitVectorCompressedColumn<T>::getSizeInBytes() const noexcept
+    {
+        return dictionary.size() * (sizeof(T) + bitmap::words_for(number_of_rows) * sizeof(bitmap::Word));
+    }
+
+    template <class T>
+    std::unique_ptr<ColumnBase> BitVectorCompressedColumn<T>::copy() const
+    {
+        return std::make_unique<BitVectorCompressedColumn<T>>(*this);
+    }
+
+    template <class T>
+    void BitVectorCompressedColumn<T>::store(const std::string &path_)
+    {
+        std::string path(path_);
+        path += this->name_;
+
+        std::ofstream outfile(path.c_str(), std::ofstream::binary | std::ofstream::out | std::ofstream::trunc);
+        assert(outfile.is_open());
+        cereal::PortableBinaryOutputArchive oarchive(outfile);
+        oarchive(*this);
+    }
+
+    template <class T>
+    void BitVectorCompressedColumn<T>::load(const std::string &path_)
+    {
+        std::string path(path_);
+        path += this->name_;
+
+        std::ifstream infile(path.c_str(), std::ifstream::binary | std::ifstream::in);
+        cereal::PortableBinaryInputArchive ia(infile);
+        ia(*this);
+    }
+
+    template <class T>
+    T BitVectorCompressedColumn<T>::operator[](const int idx)
+    {
+        return dictionary[valueOf(idx)];
+    }
+
+    template <class T>
+    PositionList BitVectorCompressedColumn<T>::selection(const ColumnType &value_for_comparison, const ValueComparator comp)
+    {
+        std::vector<size_t> qualifying = qualifyingValues(value_for_comparison, comp);
+
+        PositionList result_tids;
+        if (qualifying.size() == 1)
+        {
+            const auto &bits = bitmaps[qualifying.front()];
+            bitmap::to_positions(bits.data(), bits.size(), result_tids);
+        }
+        else if (qualifying.size() > 1)
+        {
+            std::vector<bitmap::Word> bits(bitmap::words_for(number_of_rows), 0);
+            for (size_t value_index : qualifying)
+                bitmap::bitwise_or(bits.data(), bitmaps[value_index].data(), bits.size());
+            bitmap::to_positions(bits.data(), bits.size(), result_tids);
+        }
+
+        return result_tids;
+    }
+
+    template <class T>
+    size_t BitVectorCompressedColumn<T>::count(const ColumnType &value_for_comparison, const ValueComparator comp,
+                                               unsigned int)
+    {
+        // every row is set in exactly one bitmap, so the popcounts of the qualifying bitmaps simply add up
+        size_t qualifying_rows = 0;
+        for (size_t value_index : qualifyingValues(value_for_comparison, comp))
+            qualifying_rows += bitmap::count(bitmaps[value_index].data(), bitmaps[value_index].size());
+        return qualifying_rows;
+    }
+
+    /***************** End of Implementation Section ******************/
+
+} // namespace CoGaDB
@@ -0,0 +1,184 @@
+#pragma once
+
+#include "core/base_column.hpp"
+#include "core/global_definitions.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*! \brief Helpers for bitmaps stored as vectors of 64 bit words, bit i of the bitmap is bit (i % 64) of word i / 64.
+ *  \details Bits behind the last valid bit of a bitmap are always zero, so that popcounts and conversions to position
+ * lists can work on whole words.*/
+namespace CoGaDB::bitmap
+{
+
+    using Word = uint64_t;
+
+    constexpr size_t WORD_BITS = 64;
+
+    /*! \brief number of words needed for a bitmap of number_of_bits bits */
+    constexpr size_t words_for(size_t number_of_bits)
+    {
+        return (number_of_bits + WORD_BITS - 1) / WORD_BITS;
+    }
+
+    inline unsigned popcount(Word word)
+    {
+#if defined(__GNUC__)
+        return static_cast<unsigned>(__builtin_popcountll(word));
+#else
+        unsigned count = 0;
+        for (; word != 0; word &= word - 1)
+            ++count;
+        return count;
+#endif
+    }
+
+    inline unsigned count_trailing_zeros(Word word)
+    {
+#if defined(__GNUC__)
+        return static_cast<unsigned>(__builtin_ctzll(word));
+#else
+        unsigned count = 0;
+        for (; (word & 1) == 0; word >>= 1)
+            ++count;
+        return count;
+#endif
+    }
+
+    inline bool test(const std::vector<Word> &bits, size_t position)
+    {
+        return (bits[position / WORD_BITS] >> (position % WORD_BITS)) & 1;
+    }
+
+    inline void set(std::vector<Word> &bits, size_t position)
+    {
+        bits[position / WORD_BITS] |= Word(1) << (position % WORD_BITS);
+    }
+
+    inline void clear(std::vector<Word> &bits, size_t position)
+    {
+        bits[position / WORD_BITS] &= ~(Word(1) << (position % WORD_BITS));
+    }
+
+    /*! \brief removes the bit at position from a bitmap of number_of_bits bits, all following bits move one down */
+    inline void erase(std::vector<Word> &bits, size_t position, size_t number_of_bits)
+    {
+        size_t word = position / WORD_BITS, offset = position % WORD_BITS;
+        Word low_bits = offset == 0 ? 0 : bits[word] & (~Word(0) >> (WORD_BITS - offset));
+        Word high_bits = offset == WORD_BITS - 1 ? 0 : (bits[word] >> (offset + 1)) << offset;
+        bits[word] = low_bits | high_bits;
+
+        for (; word + 1 < bits.size(); ++word)
+        {
+            bits[word] |= bits[word + 1] << (WORD_BITS - 1);
+            bits[word + 1] >>= 1;
+        }
+        bits.resize(words_for(number_of_bits - 1));
+    }
+
+    /*! \brief number of set bits in n words */
+    inline size_t count(const Word *words, size_t n)
+    {
+        size_t total = 0;
+        for (size_t i = 0; i < n; ++i)
+            total += popcount(words[i]);
+        return total;
+    }
+
+    /*! \brief destination |= source for n words */
+    inline void bitwise_or(Word *destination, const Word *source, size_t n)
+    {
+        size_t i = 0;
+#if defined(__AVX2__)
+        for (; i + 4 <= n; i += 4)
+        {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(destination + i));
+            __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + i), _mm256_or_si256(a, b));
+        }
+#elif defined(__SSE2__)
+        for (; i + 2 <= n; i += 2)
+        {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(destination + i));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + i), _mm_or_si128(a, b));
+        }
+#endif
+        for (; i < n; ++i)
+            destination[i] |= source[i];
+    }
+
+    /*! \brief destination &= source for n words */
+    inline void bitwise_and(Word *destination, const Word *source, size_t n)
+    {
+        size_t i = 0;
+#if defined(__AVX2__)
+        for (; i + 4 <= n; i += 4)
+        {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(destination + i));
+            __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + i), _mm256_and_si256(a, b));
+        }
+#elif defined(__SSE2__)
+        for (; i + 2 <= n; i += 2)
+        {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(destination + i));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + i), _mm_and_si128(a, b));
+        }
+#endif
+        for (; i < n; ++i)
+            destination[i] &= source[i];
+    }
+
+    /*! \brief flips the first number_of_bits bits of a bitmap, the bits behind them stay zero */
+    inline void bitwise_not(std::vector<Word> &bits, size_t number_of_bits)
+    {
+        Word *words = bits.data();
+        size_t i = 0, n = bits.size();
+#if defined(__AVX2__)
+        const __m256i ones = _mm256_set1_epi64x(-1);
+        for (; i + 4 <= n; i += 4)
+        {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(words + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(words + i), _mm256_xor_si256(a, ones));
+        }
+#elif defined(__SSE2__)
+        const __m128i ones = _mm_set1_epi64x(-1);
+        for (; i + 2 <= n; i += 2)
+        {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(words + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(words + i), _mm_xor_si128(a, ones));
+        }
+#endif
+        for (; i < n; ++i)
+            words[i] = ~words[i];
+
+        if (number_of_bits % WORD_BITS != 0)
+            bits.back() &= ~Word(0) >> (WORD_BITS - number_of_bits % WORD_BITS);
+    }
+
+    /*! \brief appends the positions of all set bits in n words to positions, bit 0 of the first word is row first_tid */
+    inline void to_positions(const Word *words, size_t n, PositionList &positions, TID first_tid = 0)
+    {
+        size_t start = positions.size();
+        positions.resize(start + count(words, n));
+
+        TID *out = positions.data() + start;
+        for (size_t i = 0; i < n; ++i)
+        {
+            TID word_tid = first_tid + static_cast<TID>(i * WORD_BITS);
+            for (Word word = words[i]; word != 0; word &= word - 1)
+                *out++ = word_tid + count_trailing_zeros(word);
+        }
+    }
+
+} // namespace CoGaDB::bitmap
@@ -0,0 +1,396 @@
+#pragma once
+
+#include "compressed_column.hpp"
+#include "core/global_definitions.hpp"
+#include "core/simd_kernels.hpp"
+#include <algorithm>
+#include <array>
+#include <cereal/archives/portable_binary.hpp>
+#include <cereal/types/vector.hpp>
+#include <iterator>
+#include <sstream>
+#include <type_traits>
+
+namespace CoGaDB
+{
+
+    /*!
+     *  \brief     This class represents a column with type T whose rows are compressed in blocks of a fixed number of
+     * rows by Codec.
+     *  \details   The rows are grouped into blocks of Codec::BLOCK_SIZE rows, which are encoded independently of each
+     * other. Rows that do not fill a whole block yet are kept uncompressed in the tail until the block is full. The
+     * column takes care of inserting, updating, removing and storing rows, the codec only encodes and decodes blocks.
+     * A codec has to provide
+     *  - the type Block and the constant BLOCK_SIZE,
+     *  - static Block encodeBlock(const T *values), which encodes BLOCK_SIZE rows,
+     *  - static void decodeBlock(const Block &block, T *values), which decodes all rows of block,
+     *  - static T decodeRow(const Block &block, size_t i), which decodes the row i of block,
+     *  - static size_t sizeInBytes(const Block &block).
+     *
+     * A codec that evaluates predicates on its encoded blocks provides static size_t scanBlock(const Block &block,
+     * T value, ValueComparator comp, TID first_tid, PositionList *result_tids), which appends the TIDs of the
+     * qualifying rows to result_tids unless it is a nullptr and returns their number. Otherwise selections decode the
+     * column like for all other columns.
+     */
+    template <class T, class Codec>
+    class BlockCompressedColumn final : public CompressedColumn<T>
+    {
+    public:
+        /***************** constructors and destructor *****************/
+        explicit BlockCompressedColumn(const std::string &name);
+
+        ~BlockCompressedColumn() final;
+
+        void insert(const ColumnType &new_Value) final;
+
+        void insert(const T &new_value) final;
+
+        template <typename InputIterator>
+        void insert(InputIterator first, InputIterator last);
+
+        void update(TID tid, const ColumnType &new_value) final;
+
+        /*! \brief decodes and encodes every block that holds one of the rows only once */
+        void update(PositionList &tid, const ColumnType &new_value) final;
+
+        void remove(TID tid) final;
+
+        /*! \brief decodes the blocks from the first removed row on and removes all rows in a single pass
+         *  \details assumes tid list is sorted ascending */
+        void remove(PositionList &tid) final;
+
+        void clearContent() final;
+
+        ColumnType get(TID tid) final;
+
+        std::string print() const noexcept final;
+
+        [[nodiscard]] size_t size() const noexcept final;
+
+        [[nodiscard]] size_t getSizeInBytes() const noexcept final;
+
+        [[nodiscard]] std::unique_ptr<ColumnBase> copy() const final;
+
+        void store(const std::string &path) final;
+        void load(const std::string &path) final;
+
+        T operator[](int idx) final;
+
+        /*! \brief decodes every block of the range once */
+        void decode(TID begin, size_t count, T *out) final;
+
+        /*! \brief evaluates the predicate on the encoded blocks if the codec supports it */
+        PositionList selection(const ColumnType &value_for_comparison, ValueComparator comp) final;
+
+        size_t count(const ColumnType &value_for_comparison,
+                     ValueComparator comp,
+                     unsigned int number_of_threads = 1) final;
+
+        /**
+         * @brief Serialization method called by Cereal. Implement this method in your compressed columns to get serialization working.
+         */
+        template <class Archive>
+        void serialize(Archive &archive)
+        {
+            archive(blocks, tail);
+        }
+
+    private:
+        using Block = typename Codec::Block;
+
+        static constexpr size_t BLOCK_SIZE = Codec::BLOCK_SIZE;
+
+        template <class C, class = void>
+        struct has_block_scan : std::false_type
+        {
+        };
+
+        template <class C>
+        struct has_block_scan<C, std::void_t<decltype(&C::scanBlock)>> : std::true_type
+        {
+        };
+
+        std::vector<Block> blocks; // blocks of exactly BLOCK_SIZE rows
+        std::vector<T> tail;       // rows after the last block, less than BLOCK_SIZE
+
+        // evaluates (row comp value) on all rows with the scan of the codec, appends the qualifying TIDs to
+        // result_tids unless it is a nullptr and returns the number of qualifying rows
+        size_t scan(const T &value, ValueComparator comp, PositionList *result_tids) const;
+
+        // decodes all rows from the first row of block to the end of the column and removes them from the column
+        std::vector<T> extractFrom(size_t block);
+    };
+
+    /***************** Start of Implementation Section ******************/
+
+    template <class T, class Codec>
+    BlockCompressedColumn<T, Codec>::BlockCompressedColumn(const std::string &name) : CompressedColumn<T>(name), blocks(), tail() {}
+
+    template <class T, class Codec>
+    BlockCompressedColumn<T, Codec>::~BlockCompressedColumn() = default;
+
+    template <class T, class Codec>
+    std::vector<T> BlockCompressedColumn<T, Codec>::extractFrom(size_t block)
+    {
+        std::vector<T> rows((blocks.size() - block) * BLOCK_SIZE);
+        for (size_t i = block; i < blocks.size(); ++i)
+            Codec::decodeBlock(blocks[i], rows.data() + (i - block) * BLOCK_SIZE);
+        rows.insert(rows.end(), tail.begin(), tail.end());
+
+        blocks.resize(block);
+        tail.clear();
+        return rows;
+    }
+
+    template <class T, class Codec>
+    void BlockCompressedColumn<T, Codec>::insert(const ColumnType &new_value)
+    {
+        insert(std::get<T>(new_value));
+    }
+
+    template <class T, class Codec>
+    void BlockCompressedColumn<T, Codec>::insert(const T &new_value)
+    {
+        tail.push_back(new_value);
+        if (tail.size() == BLOCK_SIZE)
+        {
+            blocks.push_back(Codec::encodeBlock(tail.data()));
+            tail.clear();
+        }
+    }
+
+    template <class T, class Codec>
+    template <typename InputIterator>
+    void BlockCompressedColumn<T, Codec>::insert(InputIterator first, InputIterator last)
+    {
+        for (InputIterator i = first; i < last; ++i)
+        {
+            insert(*i);
+        }
+    }
+
+    template <class T, class Codec>
+    void BlockCompressedColumn<T, Codec>::update(TID tid, const ColumnType &new_value)
+    {
+        PositionList positions{tid};
+        update(positions, new_value);
+    }
+
+    template <class T, class Codec>
+    void BlockCompressedColumn<T, Codec>::update(PositionList &positions, const ColumnType &new_value)
+    {
+        T value = std::get<T>(new_value);
+
+        // the rows are grouped by block, every block is decoded and encoded again once, all other blocks stay as
+        // they are
+        PositionList sorted_positions(positions);
+        std::sort(sorted_positions.begin(), sorted_positions.end());
+        const size_t sealed_rows = blocks.size() * BLOCK_SIZE;
+        std::array<T, BLOCK_SIZE> rows;
+        for (size_t i = 0; i < sorted_positions.size();)
+        {
+            size_t block = sorted_positions[i] / BLOCK_SIZE;
+            if (block >= blocks.size())
+            {
+                tail[sorted_positions[i++] - sealed_rows] = value;
+                continue;
+            }
+
+            Codec::decodeBlock(blocks[block], rows.data());
+            for (; i < sorted_positions.size() && sorted_positions[i] / BLOCK_SIZE == block; ++i)
+                rows[sorted_positions[i] % BLOCK_SIZE] = value;
+            blocks[block] = Codec::encodeBlock(rows.data());
+        }
+    }
+
+    template <class T, class Codec>
+    void BlockCompressedColumn<T, Codec>::remove(TID tid)
+    {
+        PositionList positions{tid};
+        remove(positions);
+    }
+
+    template <class T, class Codec>
+    void BlockCompressedColumn<T, Codec>::remove(PositionList &positions)
+    {
+        if (positions.empty())
+            return;
+
+        // all rows behind the first removed row move to another slot, so the blocks from there on are encoded again
+        const size_t first_row = positions.front() / BLOCK_SIZE * BLOCK_SIZE;
+        std::vector<T> rows = extractFrom(first_row / BLOCK_SIZE);
+
+        // compacts the remaining rows in a single pass
+        size_t removed = 0, write = 0;
+        for (size_t read = 0; read < rows.size(); ++read)
+        {
+            if (removed < positions.size() && positions[removed] == first_row + read)
+            {
+                removed++;
+                continue;
+            }
+            rows[write++] = rows[read];
+        }
+        rows.resize(write);
+        insert(rows.begin(), rows.end());
+    }
+
+    template <class T, class Codec>
+    void BlockCompressedColumn<T, Codec>::clearContent()
+    {
+        blocks.clear();
+        tail.clear();
+    }
+
+    template <class T, class Codec>
+    ColumnType BlockCompressedColumn<T, Codec>::get(TID tid)
+    {
+        return {operator[](tid)};
+    }
+
+    template <class T, class Codec>
+    std::string BlockCompressedColumn<T, Codec>::print() const noexcept
+    {
+        std::stringstream output;
+
+        output << this->name_ << "(" << size() << ")" << std::endl;
+        std::array<T, BLOCK_SIZE> rows;
+        for (auto const &block : blocks)
+        {
+            Codec::decodeBlock(block, rows.data());
+            for (auto const &row : rows)
+                output << row << std::endl;
+        }
+        for (auto const &row : tail)
+            output << row << std::endl;
+
+        return output.str();
+    }
+
+    template <class T, class Codec>
+    size_t BlockCompressedColumn<T, Codec>::size() const noexcept
+    {
+        return blocks.size() * BLOCK_SIZE + tail.size();
+    }
+
+    template <class T, class Codec>
+    size_t BlockCompressedColumn<T, Codec>::getSizeInBytes() const noexcept
+    {
+        size_t size_in_bytes = tail.size() * sizeof(T);
+        for (auto const &block : blocks)
+            size_in_bytes += Codec::sizeInBytes(block);
+        return size_in_bytes;
+    }
+
+    template <class T, class Codec>
+    std::unique_ptr<ColumnBase> BlockCompressedColumn<T, Codec>::copy() const
+    {
+        return std::make_unique<BlockCompressedColumn<T, Codec>>(*this);
+    }
+
+    template <class T, class Codec>
+    void BlockCompressedColumn<T, Codec>::store(const std::string &path_)
+    {
+        std::string path(path_);
+        path += this->name_;
+
+        std::ofstream outfile(path.c_str(), std::ofstream::binary | std::ofstream::out | std::ofstream::trunc);
+        assert(outfile.is_open());
+        cereal::PortableBinaryOutputArchive oarchive(outfile);
+        oarchive(*this);
+    }
+
+    template <class T, class Codec>
+    void BlockCompressedColumn<T, Codec>::load(const std::string &path_)
+    {
+        std::string path(path_);
+        path += this->name_;
+
+        std::ifstream infile(path.c_str(), std::ifstream::binary | std::ifstream::in);
+        cereal::PortableBinaryInputArchive ia(infile);
+        ia(*this);
+    }
+
+    template <class T, class Codec>
+    T BlockCompressedColumn<T, Codec>::operator[](const int idx)
+    {
+        size_t block = idx / BLOCK_SIZE;
+        if (block >= blocks.size())
+            return tail[idx - blocks.size() * BLOCK_SIZE];
+        return Codec::decodeRow(blocks[block], idx % BLOCK_SIZE);
+    }
+
+    template <class T, class Codec>
+    void BlockCompressedColumn<T, Codec>::decode(const TID begin, const size_t count, T *out)
+    {
+        const size_t end = begin + count, sealed_rows = blocks.size() * BLOCK_SIZE;
+        std::array<T, BLOCK_SIZE> rows;
+        size_t tid = begin;
+        while (tid < std::min(end, sealed_rows))
+        {
+            size_t offset = tid % BLOCK_SIZE, number_of_rows = std::min(BLOCK_SIZE - offset, end - tid);
+            // whole blocks are decoded directly into out
+            if (number_of_rows == BLOCK_SIZE)
+            {
+                Codec::decodeBlock(blocks[tid / BLOCK_SIZE], out);
+            }
+            else
+            {
+                Codec::decodeBlock(blocks[tid / BLOCK_SIZE], rows.data());
+                std::copy_n(rows.begin() + offset, number_of_rows, out);
+            }
+            out += number_of_rows;
+            tid += number_of_rows;
+        }
+        if (tid < end)
+            std::copy(tail.begin() + (tid - sealed_rows), tail.begin() + (end - sealed_rows), out);
+    }
+
+    template <class T, class Codec>
+    size_t BlockCompressedColumn<T, Codec>::scan(const T &value, const ValueComparator comp, PositionList *result_tids) const
+    {
+        size_t qualifying_rows = 0;
+        for (size_t i = 0; i < blocks.size(); ++i)
+            qualifying_rows += Codec::scanBlock(blocks[i], value, comp, static_cast<TID>(i * BLOCK_SIZE), result_tids);
+
+        std::vector<uint8_t> matches(tail.size());
+        simd::evaluate_predicate(tail.data(), tail.size(), value, comp, matches.data());
+
+        const TID first_tid = static_cast<TID>(blocks.size() * BLOCK_SIZE);
+        for (size_t i = 0; i < tail.size(); ++i)
+        {
+            if (matches[i] && result_tids)
+                result_tids->push_back(first_tid + static_cast<TID>(i));
+            qualifying_rows += matches[i];
+        }
+        return qualifying_rows;
+    }
+
+    template <class T, class Codec>
+    PositionList BlockCompressedColumn<T, Codec>::selection(const ColumnType &value_for_comparison, const ValueComparator comp)
+    {
+        if constexpr (has_block_scan<Codec>::value)
+        {
+            PositionList result_tids;
+            scan(std::get<T>(value_for_comparison), comp, &result_tids);
+            return result_tids;
+        }
+        else
+        {
+            return ColumnBaseTyped<T>::selection(value_for_comparison, comp);
+        }
+    }
+
+    template <class T, class Codec>
+    size_t BlockCompressedColumn<T, Codec>::count(const ColumnType &value_for_comparison, const ValueComparator comp,
+                                                  unsigned int number_of_threads)
+    {
+        if constexpr (has_block_scan<Codec>::value)
+            return scan(std::get<T>(value_for_comparison), comp, nullptr);
+        else
+            return ColumnBaseTyped<T>::count(value_for_comparison, comp, number_of_threads);
+    }
+
+    /***************** End of Implementation Section ******************/
+
+} // namespace CoGaDB
@@ -0,0 +1,340 @@
+#pragma once
+
+#include "bitmap.hpp"
+#include "compressed_column.hpp"
+#include "core/global_definitions.hpp"
+#include <cereal/archives/portable_binary.hpp>
+#include <cereal/types/vector.hpp>
+#include <iterator>
+#include <sstream>
+
+namespace CoGaDB
+{
+
+    /*!
+     *  \brief     This class represents a boolean column that stores a single bit per row.
+     *  \details   Row i is bit i of the bitmap. Equality selections convert the bitmap (or its complement) into a
+     * PositionList, COUNT is a popcount, and the logical operators combine two boolean columns a word at a time.
+     */
+    template <class T>
+    class BooleanCompressedColumn final : public CompressedColumn<T>
+    {
+        static_assert(std::is_same_v<T, bool>, "bit packed columns are implemented for booleans");
+
+    public:
+        /***************** constructors and destructor *****************/
+        explicit BooleanCompressedColumn(const std::string &name);
+
+        ~BooleanCompressedColumn() final;
+
+        void insert(const ColumnType &new_Value) final;
+
+        void insert(const T &new_value) final;
+
+        template <typename InputIterator>
+        void insert(InputIterator first, InputIterator last);
+
+        void update(TID tid, const ColumnType &new_value) final;
+
+        void update(PositionList &tid, const ColumnType &new_value) final;
+
+        void remove(TID tid) final;
+
+        // assumes tid list is sorted ascending
+        void remove(PositionList &tid) final;
+
+        void clearContent() final;
+
+        ColumnType get(TID tid) final;
+
+        std::string print() const noexcept final;
+
+        [[nodiscard]] size_t size() const noexcept final;
+
+        [[nodiscard]] size_t getSizeInBytes() const noexcept final;
+
+        [[nodiscard]] std::unique_ptr<ColumnBase> copy() const final;
+
+        void store(const std::string &path) final;
+        void load(const std::string &path) final;
+
+        T operator[](int idx) final;
+
+        /*! \brief converts the bitmap (true) or its complement (false) of the qualifying rows into a PositionList */
+        PositionList selection(const ColumnType &value_for_comparison, ValueComparator comp) final;
+
+        /*! \brief popcount of the bitmap of the qualifying rows */
+        size_t count(const ColumnType &value_for_comparison,
+                     ValueComparator comp,
+                     unsigned int number_of_threads = 1) final;
+
+        /*! \brief row = row && other row, false if the columns differ in size */
+        bool logical_and(ColumnBase &column);
+
+        /*! \brief row = row || other row, false if the columns differ in size */
+        bool logical_or(ColumnBase &column);
+
+        /*! \brief row = !row */
+        void logical_not();
+
+        /**
+         * @brief Serialization method called by Cereal. Implement this method in your compressed columns to get serialization working.
+         */
+        template <class Archive>
+        void serialize(Archive &archive)
+        {
+            archive(bits, number_of_rows);
+        }
+
+    private:
+        std::vector<bitmap::Word> bits; // bit i is row i
+        uint64_t number_of_rows;
+
+        // words of the rows that equal value, the complement is built in complement
+        const std::vector<bitmap::Word> &rowsEqualTo(bool value, std::vector<bitmap::Word> &complement) const;
+
+        // applies operation(destination, source, n) to the words of this column and the bits of column
+        template <class Operation>
+        bool combine(ColumnBase &column, Operation operation);
+    };
+
+    /***************** Start of Implementation Section ******************/
+
+    template <class T>
+    BooleanCompressedColumn<T>::BooleanCompressedColumn(const std::string &name)
+        : CompressedColumn<T>(name), bits(), number_of_rows(0) {}
+
+    template <class T>
+    BooleanCompressedColumn<T>::~BooleanCompressedColumn() = default;
+
+    template <class T>
+    const std::vector<bitmap::Word> &BooleanCompressedColumn<T>::rowsEqualTo(const bool value,
+                                                                             std::vector<bitmap::Word> &complement) const
+    {
+        if (value)
+            return bits;
+
+        complement = bits;
+        bitmap::bitwise_not(complement, number_of_rows);
+        return complement;
+    }
+
+    template <class T>
+    template <class Operation>
+    bool BooleanCompressedColumn<T>::combine(ColumnBase &column, Operation operation)
+    {
+        if (column.size() != size())
+            return false;
+
+        if (auto *boolean_column = dynamic_cast<BooleanCompressedColumn<T> *>(&column))
+        {
+            operation(bits.data(), boolean_column->bits.data(), bits.size());
+            return true;
+        }
+
+        // any other boolean column is packed into a bitmap first
+        auto &typed_column = dynamic_cast<ColumnBaseTyped<T> &>(column);
+        std::vector<bitmap::Word> other(bits.size(), 0);
+        for (TID tid = 0; tid < number_of_rows; tid++)
+        {
+            if (typed_column[tid])
+                bitmap::set(other, tid);
+        }
+        operation(bits.data(), other.data(), bits.size());
+        return true;
+    }
+
+    template <class T>
+    void BooleanCompressedColumn<T>::insert(const ColumnType &new_value)
+    {
+        insert(std::get<T>(new_value));
+    }
+
+    template <class T>
+    void BooleanCompressedColumn<T>::insert(const T &new_value)
+    {
+        if (number_of_rows % bitmap::WORD_BITS == 0)
+            bits.push_back(0);
+        if (new_value)
+            bitmap::set(bits, number_of_rows);
+        number_of_rows++;
+    }
+
+    template <typename T>
+    template <typename InputIterator>
+    void BooleanCompressedColumn<T>::insert(InputIterator first, InputIterator last)
+    {
+        // std::vector<bool> iterators return proxies that convert to both insert overloads
+        for (InputIterator i = first; i < last; ++i)
+        {
+            insert(static_cast<T>(*i));
+        }
+    }
+
+    template <class T>
+    void BooleanCompressedColumn<T>::update(TID tid, const ColumnType &new_value)
+    {
+        if (std::get<T>(new_value))
+            bitmap::set(bits, tid);
+        else
+            bitmap::clear(bits, tid);
+    }
+
+    template <class T>
+    void BooleanCompressedColumn<T>::update(PositionList &positions, const ColumnType &new_value)
+    {
+        for (auto &tid : positions)
+        {
+            update(tid, new_value);
+        }
+    }
+
+    template <class T>
+    void BooleanCompressedColumn<T>::remove(TID tid)
+    {
+        bitmap::erase(bits, tid, number_of_rows);
+        number_of_rows--;
+    }
+
+    template <class T>
+    void BooleanCompressedColumn<T>::remove(PositionList &positions)
+    {
+        for (auto rit = positions.rbegin(); rit != positions.rend(); ++rit)
+        {
+            remove(*rit);
+        }
+    }
+
+    template <class T>
+    void BooleanCompressedColumn<T>::clearContent()
+    {
+        bits.clear();
+        number_of_rows = 0;
+    }
+
+    template <class T>
+    ColumnType BooleanCompressedColumn<T>::get(TID tid)
+    {
+        return {operator[](tid)};
+    }
+
+    template <class T>
+    std::string BooleanCompressedColumn<T>::print() const noexcept
+    {
+        std::stringstream output;
+
+        output << this->name_ << "(" << size() << ")" << std::endl;
+        for (TID tid = 0; tid < number_of_rows; tid++)
+        {
+            output << "\t" << bitmap::test(bits, tid) << std::endl;
+        }
+
+        return output.str();
+    }
+
+    template <class T>
+    size_t BooleanCompressedColumn<T>::size() const noexcept
+    {
+        return number_of_rows;
+    }
+
+    template <class T>
+    size_t BooleanCompressedColumn<T>::getSizeInBytes() const noexcept
+    {
+        return bits.size() * sizeof(bitmap::Word);
+    }
+
+    template <class T>
+    std::unique_ptr<ColumnBase> BooleanCompressedColumn<T>::copy() const
+    {
+        return std::make_unique<BooleanCompressedColumn<T>>(*this);
+    }
+
+    template <class T>
+    void BooleanCompressedColumn<T>::store(const std::string &path_)
+    {
+        std::string path(path_);
+        path += this->name_;
+
+        std::ofstream outfile(path.c_str(), std::ofstream::binary | std::ofstream::out | std::ofstream::trunc);
+        assert(outfile.is_open());
+        cereal::PortableBinaryOutputArchive oarchive(outfile);
+        oarchive(*this);
+    }
+
+    template <class T>
+    void BooleanCompressedColumn<T>::load(const std::string &path_)
+    {
+        std::string path(path_);
+        path += this->name_;
+
+        std::ifstream infile(path.c_str(), std::ifstream::binary | std::ifstream::in);
+        cereal::PortableBinaryInputArchive ia(infile);
+        ia(*this);
+    }
+
+    template <class T>
+    T BooleanCompressedColumn<T>::operator[](const int idx)
+    {
+        return bitmap::test(bits, idx);
+    }
+
+    template <class T>
+    PositionList BooleanCompressedColumn<T>::selection(const ColumnType &value_for_comparison, const ValueComparator comp)
+    {
+        bool value = std::get<T>(value_for_comparison);
+
+        // false < true, so LESSER true selects the false rows and GREATER false selects the true rows
+        PositionList result_tids;
+        std::vector<bitmap::Word> complement;
+        if (comp == EQUAL)
+        {
+            const auto &rows = rowsEqualTo(value, complement);
+            bitmap::to_positions(rows.data(), rows.size(), result_tids);
+        }
+        else if ((comp == LESSER && value) || (comp == GREATER && !value))
+        {
+            const auto &rows = rowsEqualTo(comp == GREATER, complement);
+            bitmap::to_positions(rows.data(), rows.size(), result_tids);
+        }
+
+        return result_tids;
+    }
+
+    template <class T>
+    size_t BooleanCompressedColumn<T>::count(const ColumnType &value_for_comparison, const ValueComparator comp,
+                                             unsigned int)
+    {
+        bool value = std::get<T>(value_for_comparison);
+
+        size_t true_rows = bitmap::count(bits.data(), bits.size());
+        if (comp == EQUAL)
+            return value ? true_rows : number_of_rows - true_rows;
+        if (comp == LESSER && value)
+            return number_of_rows - true_rows;
+        if (comp == GREATER && !value)
+            return true_rows;
+        return 0;
+    }
+
+    template <class T>
+    bool BooleanCompressedColumn<T>::logical_and(ColumnBase &column)
+    {
+        return combine(column, bitmap::bitwise_and);
+    }
+
+    template <class T>
+    bool BooleanCompressedColumn<T>::logical_or(ColumnBase &column)
+    {
+        return combine(column, bitmap::bitwise_or);
+    }
+
+    template <class T>
+    void BooleanCompressedColumn<T>::logical_not()
+    {
+        bitmap::bitwise_not(bits, number_of_rows);
+    }
+
+    /***************** End of Implementation Section ******************/
+
+} // namespace CoGaDB
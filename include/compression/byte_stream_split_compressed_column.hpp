@@ -0,0 +1,80 @@
+#pragma once
+
+#include "block_compressed_column.hpp"
+#include "core/byte_stream_split.hpp"
+#include <array>
+
+namespace CoGaDB
+{
+
+    /*!
+     *  \brief     This class represents the byte stream split coding of blocks of a floating point type T.
+     *  \details   Every block transposes the bytes of its rows into sizeof(T) byte streams, see byte_stream_split.hpp,
+     * and run-length encodes the streams that compress. Sign and exponent bytes of values of similar magnitude form long
+     * runs, while the noisy low order mantissa bytes are kept as they are. Accessing a row decodes a single block, so
+     * operator[] is O(BLOCK_SIZE). The encoding is meant for cold data that is mostly scanned.
+     */
+    template <class T>
+    struct ByteStreamSplitCodec
+    {
+        static_assert(std::is_floating_point_v<T>, "byte stream split is implemented for floating point values");
+
+        static constexpr size_t BLOCK_SIZE = 1024;
+
+        struct Block
+        {
+            std::vector<byte_stream_split::Stream> streams; // one stream per byte of the rows
+
+            template <class Archive>
+            void serialize(Archive &archive)
+            {
+                archive(streams);
+            }
+        };
+
+        static Block encodeBlock(const T *values);
+
+        static void decodeBlock(const Block &block, T *values);
+
+        static T decodeRow(const Block &block, size_t i);
+
+        static size_t sizeInBytes(const Block &block);
+    };
+
+    /*!
+     *  \brief     This class represents a byte-stream-split column with a floating point type T.
+     */
+    template <class T>
+    using ByteStreamSplitCompressedColumn = BlockCompressedColumn<T, ByteStreamSplitCodec<T>>;
+
+    /***************** Start of Implementation Section ******************/
+
+    template <class T>
+    typename ByteStreamSplitCodec<T>::Block ByteStreamSplitCodec<T>::encodeBlock(const T *values)
+    {
+        return {byte_stream_split::encode(values, BLOCK_SIZE)};
+    }
+
+    template <class T>
+    void ByteStreamSplitCodec<T>::decodeBlock(const Block &block, T *values)
+    {
+        byte_stream_split::decode(block.streams, BLOCK_SIZE, values);
+    }
+
+    template <class T>
+    T ByteStreamSplitCodec<T>::decodeRow(const Block &block, size_t i)
+    {
+        std::array<T, BLOCK_SIZE> rows;
+        decodeBlock(block, rows.data());
+        return rows[i];
+    }
+
+    template <class T>
+    size_t ByteStreamSplitCodec<T>::sizeInBytes(const Block &block)
+    {
+        return byte_stream_split::size_in_bytes(block.streams);
+    }
+
+    /***************** End of Implementation Section ******************/
+
+} // namespace CoGaDB
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "bit_packing.hpp"
+#include "block_compressed_column.hpp"
+#include "core/simd_kernels.hpp"
+#include <array>
+
+namespace CoGaDB
+{
+
+    /*!
+     *  \brief     This class represents the delta coding of blocks of a signed integer type T.
+     *  \details   Every block stores the absolute value of its first row as checkpoint, followed by the zig-zag encoded
+     * differences between neighbouring rows, bit-packed with the smallest bit width that fits all differences of the
+     * block. Accessing a row decodes a single block, so operator[] is O(BLOCK_SIZE).
+     */
+    template <class T>
+    struct DeltaCodec
+    {
+        static_assert(std::is_integral_v<T> && std::is_signed_v<T>, "delta coding is implemented for signed integers");
+
+        using Unsigned = std::make_unsigned_t<T>;
+
+        static constexpr size_t BLOCK_SIZE = 128;
+
+        struct Block
+        {
+            T checkpoint = 0;             // absolute value of the first row of the block
+            uint8_t bit_width = 0;        // bits per packed difference
+            std::vector<Unsigned> packed; // BLOCK_SIZE - 1 zig-zag encoded differences
+
+            template <class Archive>
+            void serialize(Archive &archive)
+            {
+                archive(checkpoint, bit_width, packed);
+            }
+        };
+
+        static Block encodeBlock(const T *values);
+
+        static void decodeBlock(const Block &block, T *values);
+
+        static T decodeRow(const Block &block, size_t i);
+
+        static size_t sizeInBytes(const Block &block);
+    };
+
+    /*!
+     *  \brief     This class represents a delta compressed column with a signed integer type T.
+     */
+    template <class T>
+    using DeltaCompressedColumn = BlockCompressedColumn<T, DeltaCodec<T>>;
+
+    /***************** Start of Implementation Section ******************/
+
+    template <class T>
+    typename DeltaCodec<T>::Block DeltaCodec<T>::encodeBlock(const T *values)
+    {
+        Block block;
+        block.checkpoint = values[0];
+
+        std::array<Unsigned, BLOCK_SIZE - 1> deltas;
+        Unsigned all_bits = 0;
+        for (size_t i = 1; i < BLOCK_SIZE; ++i)
+        {
+            Unsigned delta = static_cast<Unsigned>(values[i]) - static_cast<Unsigned>(values[i - 1]);
+            deltas[i - 1] = bit_packing::zigzag_encode(delta);
+            all_bits |= deltas[i - 1];
+        }
+
+        block.bit_width = static_cast<uint8_t>(bit_packing::required_bit_width(all_bits));
+        block.packed.resize(bit_packing::packed_size<Unsigned>(deltas.size(), block.bit_width));
+        bit_packing::pack(deltas.data(), deltas.size(), block.bit_width, block.packed.data());
+        return block;
+    }
+
+    template <class T>
+    void DeltaCodec<T>::decodeBlock(const Block &block, T *values)
+    {
+        std::array<Unsigned, BLOCK_SIZE - 1> deltas;
+        bit_packing::unpack(block.packed.data(), deltas.size(), block.bit_width, deltas.data());
+
+        values[0] = block.checkpoint;
+        for (size_t i = 1; i < BLOCK_SIZE; ++i)
+            values[i] = static_cast<T>(bit_packing::zigzag_decode(deltas[i - 1]));
+        simd::inclusive_prefix_sum(values + 1, BLOCK_SIZE - 1, block.checkpoint);
+    }
+
+    template <class T>
+    T DeltaCodec<T>::decodeRow(const Block &block, size_t i)
+    {
+        std::array<T, BLOCK_SIZE> rows;
+        decodeBlock(block, rows.data());
+        return rows[i];
+    }
+
+    template <class T>
+    size_t DeltaCodec<T>::sizeInBytes(const Block &block)
+    {
+        return sizeof(block.checkpoint) + sizeof(block.bit_width) + block.packed.size() * sizeof(Unsigned);
+    }
+
+    /***************** End of Implementation Section ******************/
+
+} // namespace CoGaDB
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "bit_packing.hpp"
 #include "compressed_column.hpp"
 #include "core/global_definitions.hpp"
 #include <cereal/archives/portable_binary.hpp>
@@ -13,6 +14,8 @@
 #include <cereal/types/vector.hpp>
 #include <iterator>
 #include <map>
+#include <numeric>
+#include <unordered_map>
 
 namespace CoGaDB
 {
@@ -20,6 +23,12 @@ namespace CoGaDB
     /*!
      *  \brief     This class represents a dictionary compressed column with type T, is the base class for all
      * compressed typed column classes.
+     *  \details   The codes of the rows are sealed into segments of SEGMENT_SIZE codes, which are stored like the
+     * RLE/bit-packing hybrid of Parquet: repeats of at least MIN_RUN_LENGTH codes become runs, all other codes are
+     * bit-packed in groups of 8 with the bit width of the largest code of the segment. If that is not smaller than
+     * bit-packing the whole segment, the segment is bit-packed as a single group run. Codes of rows that do not fill a
+     * whole segment yet are kept uncompressed. Selections evaluate the predicate once per dictionary entry and then
+     * decode one segment at a time into a batch of codes that is checked against the qualifying codes.
      */
     template <class T>
     class DictionaryCompressedColumn final : public CompressedColumn<T>
@@ -39,6 +48,7 @@ namespace CoGaDB
 
         void update(TID tid, const ColumnType &new_value) final;
 
+        /*! \brief decodes and encodes every segment that holds one of the rows only once */
         void update(PositionList &tid, const ColumnType &new_value) final;
 
         void remove(TID tid) final;
@@ -64,55 +74,571 @@ namespace CoGaDB
 
         T operator[](int idx) final;
 
+        /*! \brief decodes one segment at a time and looks the codes up in the dictionary */
+        void decode(TID begin, size_t count, T *out) final;
+
+        /*! \brief evaluates the predicate on the dictionary and checks the decoded codes against the qualifying codes */
+        PositionList selection(const ColumnType &value_for_comparison, ValueComparator comp) final;
+
+        size_t count(const ColumnType &value_for_comparison,
+                     ValueComparator comp,
+                     unsigned int number_of_threads = 1) final;
+
+        /*! \brief walks the dictionary in sorted order and counts the rows per code to find the codes of the first k
+         * rows, then collects their TIDs in a single pass over the codes */
+        PositionList topK(size_t k, SortOrder order = ASCENDING, unsigned int number_of_threads = 1) final;
+
+        /*! \brief the arithmetic operations with a value map over the dictionary and rewrite the codes segment by
+         * segment, entries that end up with the same value are merged */
+        bool add(const ColumnType &new_value) final;
+
+        /*! \brief the arithmetic operations between columns decode the other column one segment at a time and encode
+         * the results into a new dictionary */
+        bool add(ColumnBase &column) final;
+
+        bool minus(const ColumnType &new_value) final;
+
+        bool minus(ColumnBase &column) final;
+
+        bool multiply(const ColumnType &new_value) final;
+
+        bool multiply(ColumnBase &column) final;
+
+        bool division(const ColumnType &new_value) final;
+
+        bool division(ColumnBase &column) final;
+
         /**
          * @brief Serialization method called by Cereal. Implement this method in your compressed columns to get serialization working.
+         * @details The format starts with a marker and a version number. Files written before the codes were stored in
+         * segments start with the length of the dictionary, followed by the dictionary and the vector of codes.
          */
         template <class Archive>
         void serialize(Archive &archive)
         {
-            archive(dictionary, table); // serialize things by passing them to the archive
+            if constexpr (Archive::is_loading::value)
+            {
+                uint64_t header = 0;
+                archive(header);
+                if (header == FORMAT_MARKER)
+                {
+                    uint32_t version = 0;
+                    archive(version);
+                    if (version != FORMAT_VERSION)
+                        throw cereal::Exception("unsupported dictionary column format version " + std::to_string(version));
+                    archive(dictionary, segments, table);
+                }
+                else
+                {
+                    // legacy format, header is the length of the dictionary and the codes follow as one vector
+                    dictionary.resize(header);
+                    for (auto &record : dictionary)
+                        archive(record);
+                    std::vector<size_t> codes;
+                    archive(codes);
+
+                    segments.clear();
+                    table.clear();
+                    for (size_t code : codes)
+                        appendCode(static_cast<Code>(code));
+                }
+            }
+            else
+            {
+                archive(FORMAT_MARKER, FORMAT_VERSION, dictionary, segments, table); // serialize things by passing them to the archive
+            }
         }
 
     private:
+        using Code = uint32_t;
+
+        static constexpr uint64_t FORMAT_MARKER = UINT64_MAX;
+        static constexpr uint32_t FORMAT_VERSION = 1;
+
+        static constexpr size_t SEGMENT_SIZE = 1024;
+        // repeats shorter than this are cheaper as part of a bit-packed group
+        static constexpr size_t MIN_RUN_LENGTH = 8;
+        static constexpr size_t GROUP_SIZE = 8;
+
+        struct Segment
+        {
+            uint8_t bit_width = 0;        // bits per code of the segment
+            std::vector<Code> headers;    // (run length << 1) for runs, (number of groups << 1) | 1 for group runs
+            std::vector<Code> run_values; // code of every run
+            std::vector<Code> packed;     // codes of all groups of the segment, bit-packed with bit_width
+
+            template <class Archive>
+            void serialize(Archive &archive)
+            {
+                archive(bit_width, headers, run_values, packed);
+            }
+        };
+
         std::vector<T> dictionary;
-        std::vector<size_t> table;
+        std::vector<Segment> segments; // segments of exactly SEGMENT_SIZE codes
+        std::vector<Code> table;       // codes of the rows after the last segment, less than SEGMENT_SIZE
+
+        void appendCode(Code code);
+
+        // code of value, value is appended to the dictionary if it is not part of it yet
+        Code codeOf(const T &value);
+
+        static Segment encodeSegment(const Code *codes);
+
+        static void decodeSegment(const Segment &segment, Code *codes);
+
+        // code of row tid without decoding its whole segment
+        Code codeAt(TID tid) const;
+
+        // decodes all codes from the first row of segment to the end of the column and removes them from the column
+        std::vector<Code> extractFrom(size_t segment);
+
+        // calls function(codes, first, n) for every segment and the rows after the last segment, codes holds the n
+        // decoded codes starting at row first
+        template <class Function>
+        void forEachSegment(Function function) const;
+
+        // like forEachSegment, but function may change the codes, which are encoded again afterwards
+        template <class Function>
+        void recodeSegments(Function function);
+
+        template <class Operation>
+        bool mapCodes(const ColumnType &value, Operation op);
+
+        template <class Operation>
+        bool zipCodes(ColumnBase &column, Operation op);
+
+        // evaluates (row comp value) on all rows, appends the qualifying TIDs to result_tids unless it is a nullptr and
+        // returns the number of qualifying rows
+        size_t scan(const T &value, ValueComparator comp, PositionList *result_tids) const;
     };
 
     /***************** Start of Implementation Section ******************/
 
     template <class T>
-    DictionaryCompressedColumn<T>::DictionaryCompressedColumn(const std::string &name) : CompressedColumn<T>(name), dictionary(), table() {}
+    DictionaryCompressedColumn<T>::DictionaryCompressedColumn(const std::string &name) : CompressedColumn<T>(name), dictionary(), segments(), table() {}
 
     template <class T>
     DictionaryCompressedColumn<T>::~DictionaryCompressedColumn() = default;
 
     template <class T>
-    void DictionaryCompressedColumn<T>::insert(const ColumnType &newRecord)
+    void DictionaryCompressedColumn<T>::appendCode(const Code code)
     {
-        const T &newRecordValue = std::get<T>(newRecord);
-        insert(newRecordValue);
+        table.push_back(code);
+        if (table.size() == SEGMENT_SIZE)
+        {
+            segments.push_back(encodeSegment(table.data()));
+            table.clear();
+        }
     }
 
     template <class T>
-    void DictionaryCompressedColumn<T>::insert(const T &newRecord)
+    typename DictionaryCompressedColumn<T>::Code DictionaryCompressedColumn<T>::codeOf(const T &value)
+    {
+        // search dictionary for existing record, if not, insert new reference
+        for (size_t i = 0; i < dictionary.size(); i++)
+        {
+            if (value == dictionary[i])
+                return static_cast<Code>(i);
+        }
+        dictionary.push_back(value);
+        return static_cast<Code>(dictionary.size() - 1);
+    }
+
+    template <class T>
+    typename DictionaryCompressedColumn<T>::Segment DictionaryCompressedColumn<T>::encodeSegment(const Code *codes)
     {
+        Segment segment;
+        segment.bit_width = static_cast<uint8_t>(bit_packing::required_bit_width(*std::max_element(codes, codes + SEGMENT_SIZE)));
+
+        std::vector<Code> grouped;
+        for (size_t i = 0; i < SEGMENT_SIZE;)
+        {
+            size_t run_length = 1;
+            while (i + run_length < SEGMENT_SIZE && codes[i + run_length] == codes[i])
+                run_length++;
 
-        // search dictionary for existing record
+            if (run_length >= MIN_RUN_LENGTH)
+            {
+                segment.headers.push_back(static_cast<Code>(run_length << 1));
+                segment.run_values.push_back(codes[i]);
+                i += run_length;
+                continue;
+            }
+
+            // a group of 8 codes, the last group of the segment is padded with zeros
+            if (segment.headers.empty() || (segment.headers.back() & 1) == 0)
+                segment.headers.push_back(1);
+            segment.headers.back() += 2;
+            for (size_t j = i; j < i + GROUP_SIZE; ++j)
+                grouped.push_back(j < SEGMENT_SIZE ? codes[j] : 0);
+            i += GROUP_SIZE;
+        }
+
+        // runs cost a header and a code, the hybrid pays off only if that beats packing all codes
+        size_t hybrid_bits = (segment.headers.size() + segment.run_values.size()) * sizeof(Code) * 8 +
+                             grouped.size() * segment.bit_width;
+        if (hybrid_bits >= sizeof(Code) * 8 + SEGMENT_SIZE * segment.bit_width)
+        {
+            segment.headers.assign(1, static_cast<Code>(((SEGMENT_SIZE / GROUP_SIZE) << 1) | 1));
+            segment.run_values.clear();
+            grouped.assign(codes, codes + SEGMENT_SIZE);
+        }
+
+        segment.packed.resize(bit_packing::packed_size<Code>(grouped.size(), segment.bit_width));
+        bit_packing::pack(grouped.data(), grouped.size(), segment.bit_width, segment.packed.data());
+        return segment;
+    }
+
+    template <class T>
+    void DictionaryCompressedColumn<T>::decodeSegment(const Segment &segment, Code *codes)
+    {
+        size_t number_of_grouped = 0;
+        for (Code header : segment.headers)
+        {
+            if (header & 1)
+                number_of_grouped += (header >> 1) * GROUP_SIZE;
+        }
+        std::vector<Code> grouped(number_of_grouped);
+        bit_packing::unpack(segment.packed.data(), grouped.size(), segment.bit_width, grouped.data());
+
+        size_t row = 0, group_code = 0, run = 0;
+        for (Code header : segment.headers)
+        {
+            size_t length = header >> 1;
+            if (header & 1)
+            {
+                // the padding of the last group is not copied
+                size_t number_of_codes = std::min(length * GROUP_SIZE, SEGMENT_SIZE - row);
+                std::copy_n(grouped.begin() + group_code, number_of_codes, codes + row);
+                group_code += length * GROUP_SIZE;
+                row += number_of_codes;
+            }
+            else
+            {
+                std::fill(codes + row, codes + row + length, segment.run_values[run++]);
+                row += length;
+            }
+        }
+    }
+
+    template <class T>
+    typename DictionaryCompressedColumn<T>::Code DictionaryCompressedColumn<T>::codeAt(const TID tid) const
+    {
+        size_t segment_index = tid / SEGMENT_SIZE;
+        if (segment_index >= segments.size())
+            return table[tid - segments.size() * SEGMENT_SIZE];
+
+        // walks the runs of the segment, only the code of the row itself is unpacked
+        const Segment &segment = segments[segment_index];
+        size_t row = 0, offset = tid % SEGMENT_SIZE, group_code = 0, run = 0;
+        for (Code header : segment.headers)
+        {
+            size_t length = header >> 1;
+            if (header & 1)
+            {
+                if (offset < row + length * GROUP_SIZE)
+                    return bit_packing::extract(segment.packed.data(), segment.bit_width, group_code + offset - row);
+                group_code += length * GROUP_SIZE;
+                row += length * GROUP_SIZE;
+            }
+            else
+            {
+                if (offset < row + length)
+                    return segment.run_values[run];
+                run++;
+                row += length;
+            }
+        }
+        return 0;
+    }
+
+    template <class T>
+    std::vector<typename DictionaryCompressedColumn<T>::Code> DictionaryCompressedColumn<T>::extractFrom(size_t segment)
+    {
+        std::vector<Code> codes((segments.size() - segment) * SEGMENT_SIZE);
+        for (size_t i = segment; i < segments.size(); ++i)
+            decodeSegment(segments[i], codes.data() + (i - segment) * SEGMENT_SIZE);
+        codes.insert(codes.end(), table.begin(), table.end());
+
+        segments.resize(segment);
+        table.clear();
+        return codes;
+    }
+
+    template <class T>
+    size_t DictionaryCompressedColumn<T>::scan(const T &value, const ValueComparator comp, PositionList *result_tids) const
+    {
+        // the predicate is evaluated once per dictionary entry
+        std::vector<uint8_t> qualifies(dictionary.size());
         for (size_t i = 0; i < dictionary.size(); i++)
         {
             auto &record = dictionary[i];
-            if (newRecord == record)
+            qualifies[i] = (comp == EQUAL && record == value) || (comp == LESSER && record < value) ||
+                           (comp == GREATER && record > value);
+        }
+
+        size_t qualifying_rows = 0;
+        forEachSegment([&](const Code *codes, TID first, size_t number_of_codes)
+        {
+            for (size_t i = 0; i < number_of_codes; ++i)
             {
-                // if record exists, insert dictonary index into table
-                table.push_back(i);
-                return;
+                if (qualifies[codes[i]] && result_tids)
+                    result_tids->push_back(static_cast<TID>(first + i));
+                qualifying_rows += qualifies[codes[i]];
             }
+        });
+        return qualifying_rows;
+    }
+
+    template <class T>
+    template <class Function>
+    void DictionaryCompressedColumn<T>::forEachSegment(Function function) const
+    {
+        std::vector<Code> batch(SEGMENT_SIZE);
+        for (size_t segment = 0; segment < segments.size(); ++segment)
+        {
+            decodeSegment(segments[segment], batch.data());
+            function(static_cast<const Code *>(batch.data()), static_cast<TID>(segment * SEGMENT_SIZE), SEGMENT_SIZE);
         }
+        function(table.data(), static_cast<TID>(segments.size() * SEGMENT_SIZE), table.size());
+    }
 
-        // if new record, insert into dictonary and then insert index into table
-        size_t newIdx = dictionary.size();
-        dictionary.push_back(newRecord);
-        table.push_back(newIdx);
+    template <class T>
+    template <class Function>
+    void DictionaryCompressedColumn<T>::recodeSegments(Function function)
+    {
+        std::vector<Code> batch(SEGMENT_SIZE);
+        for (size_t segment = 0; segment < segments.size(); ++segment)
+        {
+            decodeSegment(segments[segment], batch.data());
+            function(batch.data(), static_cast<TID>(segment * SEGMENT_SIZE), SEGMENT_SIZE);
+            segments[segment] = encodeSegment(batch.data());
+        }
+        function(table.data(), static_cast<TID>(segments.size() * SEGMENT_SIZE), table.size());
+    }
+
+    template <class T>
+    template <class Operation>
+    bool DictionaryCompressedColumn<T>::mapCodes(const ColumnType &new_value, Operation op)
+    {
+        if (std::holds_alternative<std::monostate>(new_value))
+            return false;
+
+        // the operation is applied once per dictionary entry, distinct entries may map to the same result
+        const T &value = std::get<T>(new_value);
+        std::vector<T> old_dictionary = std::move(dictionary);
+        dictionary.clear();
+        std::unordered_map<T, Code> index;
+        std::vector<Code> new_codes(old_dictionary.size());
+        for (size_t i = 0; i < old_dictionary.size(); ++i)
+        {
+            auto result = index.emplace(static_cast<T>(op(old_dictionary[i], value)), static_cast<Code>(dictionary.size()));
+            if (result.second)
+                dictionary.push_back(result.first->first);
+            new_codes[i] = result.first->second;
+        }
+
+        recodeSegments([&](Code *codes, TID, size_t n)
+        {
+            for (size_t i = 0; i < n; ++i)
+                codes[i] = new_codes[codes[i]];
+        });
+        return true;
+    }
+
+    template <class T>
+    template <class Operation>
+    bool DictionaryCompressedColumn<T>::zipCodes(ColumnBase &column, Operation op)
+    {
+        auto &typed_column = dynamic_cast<ColumnBaseTyped<T> &>(column);
+        if (typed_column.size() != size())
+            return false;
+
+        // the results get a new dictionary, entries that no row refers to anymore are dropped
+        const bool is_self = &column == this;
+        std::vector<T> old_dictionary = std::move(dictionary);
+        dictionary.clear();
+        std::unordered_map<T, Code> index;
+        std::vector<T> other_values(SEGMENT_SIZE);
+        recodeSegments([&](Code *codes, TID first, size_t n)
+        {
+            if (is_self)
+            {
+                for (size_t i = 0; i < n; ++i)
+                    other_values[i] = old_dictionary[codes[i]];
+            }
+            else
+            {
+                typed_column.decode(first, n, other_values.data());
+            }
+
+            for (size_t i = 0; i < n; ++i)
+            {
+                auto result = index.emplace(static_cast<T>(op(old_dictionary[codes[i]], other_values[i])),
+                                            static_cast<Code>(dictionary.size()));
+                if (result.second)
+                    dictionary.push_back(result.first->first);
+                codes[i] = result.first->second;
+            }
+        });
+        return true;
+    }
+
+    template <class T>
+    bool DictionaryCompressedColumn<T>::add(const ColumnType &new_value)
+    {
+        if constexpr (std::is_same_v<T, std::string>)
+            return ColumnBaseTyped<T>::add(new_value);
+        else
+            return mapCodes(new_value, std::plus<T>());
+    }
+
+    template <class T>
+    bool DictionaryCompressedColumn<T>::add(ColumnBase &column)
+    {
+        if constexpr (std::is_same_v<T, std::string>)
+            return ColumnBaseTyped<T>::add(column);
+        else
+            return zipCodes(column, std::plus<T>());
+    }
+
+    template <class T>
+    bool DictionaryCompressedColumn<T>::minus(const ColumnType &new_value)
+    {
+        if constexpr (std::is_same_v<T, std::string>)
+            return ColumnBaseTyped<T>::minus(new_value);
+        else
+            return mapCodes(new_value, std::minus<T>());
+    }
+
+    template <class T>
+    bool DictionaryCompressedColumn<T>::minus(ColumnBase &column)
+    {
+        if constexpr (std::is_same_v<T, std::string>)
+            return ColumnBaseTyped<T>::minus(column);
+        else
+            return zipCodes(column, std::minus<T>());
+    }
+
+    template <class T>
+    bool DictionaryCompressedColumn<T>::multiply(const ColumnType &new_value)
+    {
+        if constexpr (std::is_same_v<T, std::string>)
+            return ColumnBaseTyped<T>::multiply(new_value);
+        else
+            return mapCodes(new_value, std::multiplies<T>());
+    }
+
+    template <class T>
+    bool DictionaryCompressedColumn<T>::multiply(ColumnBase &column)
+    {
+        if constexpr (std::is_same_v<T, std::string>)
+            return ColumnBaseTyped<T>::multiply(column);
+        else
+            return zipCodes(column, std::multiplies<T>());
+    }
+
+    template <class T>
+    bool DictionaryCompressedColumn<T>::division(const ColumnType &new_value)
+    {
+        if constexpr (std::is_same_v<T, std::string>)
+        {
+            return ColumnBaseTyped<T>::division(new_value);
+        }
+        else
+        {
+            // check that we do not divide by zero
+            if (std::holds_alternative<T>(new_value) && std::get<T>(new_value) == 0)
+                return false;
+            return mapCodes(new_value, std::divides<T>());
+        }
+    }
+
+    template <class T>
+    bool DictionaryCompressedColumn<T>::division(ColumnBase &column)
+    {
+        if constexpr (std::is_same_v<T, std::string>)
+            return ColumnBaseTyped<T>::division(column);
+        else
+            return zipCodes(column, std::divides<T>());
+    }
+
+    template <class T>
+    PositionList DictionaryCompressedColumn<T>::topK(size_t k, SortOrder order, unsigned int number_of_threads)
+    {
+        if ((order != ASCENDING && order != DESCENDING) || k >= size())
+            return ColumnBaseTyped<T>::topK(k, order, number_of_threads);
+
+        // codes in the order of their dictionary entries, the entries are distinct
+        std::vector<Code> sorted_codes(dictionary.size());
+        std::iota(sorted_codes.begin(), sorted_codes.end(), Code(0));
+        std::sort(sorted_codes.begin(), sorted_codes.end(), [this, order](Code a, Code b)
+                  { return order == ASCENDING ? dictionary[a] < dictionary[b] : dictionary[b] < dictionary[a]; });
+        std::vector<size_t> ranks(dictionary.size());
+        for (size_t rank = 0; rank < sorted_codes.size(); ++rank)
+            ranks[sorted_codes[rank]] = rank;
+
+        std::vector<size_t> rows_per_code(dictionary.size(), 0);
+        forEachSegment([&](const Code *codes, TID, size_t n)
+        {
+            for (size_t i = 0; i < n; ++i)
+                rows_per_code[codes[i]]++;
+        });
+
+        // the codes before the cutoff contribute all of their rows, the cutoff code the remaining ones: equal values
+        // are ordered by ascending TID for ASCENDING, so its first rows qualify, and by descending TID for DESCENDING,
+        // so its last rows qualify
+        size_t cutoff = 0, remaining = k;
+        while (rows_per_code[sorted_codes[cutoff]] < remaining)
+            remaining -= rows_per_code[sorted_codes[cutoff++]];
+        size_t skipped_rows = order == ASCENDING ? 0 : rows_per_code[sorted_codes[cutoff]] - remaining;
+
+        std::vector<std::pair<size_t, TID>> rows; // (rank, TID) of the first k rows
+        rows.reserve(k);
+        forEachSegment([&](const Code *codes, TID first, size_t n)
+        {
+            for (size_t i = 0; i < n; ++i)
+            {
+                size_t rank = ranks[codes[i]];
+                if (rank < cutoff)
+                {
+                    rows.emplace_back(rank, static_cast<TID>(first + i));
+                }
+                else if (rank == cutoff && remaining > 0)
+                {
+                    if (skipped_rows > 0)
+                    {
+                        skipped_rows--;
+                        continue;
+                    }
+                    rows.emplace_back(rank, static_cast<TID>(first + i));
+                    remaining--;
+                }
+            }
+        });
+
+        std::sort(rows.begin(), rows.end(), [order](const auto &a, const auto &b)
+                  { return a.first < b.first ||
+                           (a.first == b.first && (order == ASCENDING ? a.second < b.second : a.second > b.second)); });
+
+        PositionList ids(rows.size());
+        for (size_t i = 0; i < rows.size(); ++i)
+            ids[i] = rows[i].second;
+        return ids;
+    }
+
+    template <class T>
+    void DictionaryCompressedColumn<T>::insert(const ColumnType &newRecord)
+    {
+        const T &newRecordValue = std::get<T>(newRecord);
+        insert(newRecordValue);
+    }
+
+    template <class T>
+    void DictionaryCompressedColumn<T>::insert(const T &newRecord)
+    {
+        appendCode(codeOf(newRecord));
     }
 
     template <typename T>
@@ -137,8 +663,9 @@ namespace CoGaDB
         std::stringstream output;
 
         output << this->name_ << "(" << size() << ")" << std::endl;
-        for (auto const &key : table)
+        for (TID tid = 0; tid < size(); tid++)
         {
+            Code key = codeAt(tid);
             output << "\t" << key << ": " << dictionary[key] << std::endl;
         }
 
@@ -148,7 +675,7 @@ namespace CoGaDB
     template <class T>
     size_t DictionaryCompressedColumn<T>::size() const noexcept
     {
-        return table.size();
+        return segments.size() * SEGMENT_SIZE + table.size();
     }
 
     template <class T>
@@ -160,57 +687,70 @@ namespace CoGaDB
     template <class T>
     void DictionaryCompressedColumn<T>::update(TID tid, const ColumnType &newRecord)
     {
-        const T &newRecordValue = std::get<T>(newRecord);
-
-        // search dictionary for existing record
-        for (size_t i = 0; i < dictionary.size(); i++)
-        {
-            auto &record = dictionary[i];
-            // if record exists, change reference in table (dictionary index)
-            if (newRecordValue == record)
-            {
-                table[tid] = i;
-                return;
-            }
-        }
-
-        // if not, insert new reference
-        size_t newIdx = dictionary.size();
-        dictionary.push_back(newRecordValue);
-        table[tid] = newIdx;
+        PositionList positions{tid};
+        update(positions, newRecord);
     }
 
     template <class T>
     void DictionaryCompressedColumn<T>::update(PositionList &positions, const ColumnType &data)
     {
-        for (auto &tid : positions)
+        if (positions.empty())
+            return;
+        const Code code = codeOf(std::get<T>(data));
+
+        // change reference in table (dictionary index), the rows are grouped by segment, so that every sealed
+        // segment is decoded and encoded again only once
+        PositionList sorted_positions(positions);
+        std::sort(sorted_positions.begin(), sorted_positions.end());
+        const size_t sealed_rows = segments.size() * SEGMENT_SIZE;
+        std::vector<Code> codes;
+        for (size_t i = 0; i < sorted_positions.size();)
         {
-            update(tid, data);
+            size_t segment = sorted_positions[i] / SEGMENT_SIZE;
+            if (segment >= segments.size())
+            {
+                table[sorted_positions[i++] - sealed_rows] = code;
+                continue;
+            }
+
+            codes.resize(SEGMENT_SIZE);
+            decodeSegment(segments[segment], codes.data());
+            for (; i < sorted_positions.size() && sorted_positions[i] / SEGMENT_SIZE == segment; ++i)
+                codes[sorted_positions[i] % SEGMENT_SIZE] = code;
+            segments[segment] = encodeSegment(codes.data());
         }
     }
 
     template <class T>
     void DictionaryCompressedColumn<T>::remove(TID tid)
     {
-        // remove reference from table with offset tid
-        // we don't remove record from dictionary because if so we would have to shift the table indices
-        // furthermore it's possible that the record is used at another index in table and if not
-        // it's possible it will be used again in the future
-        table.erase(table.begin() + tid);
+        PositionList positions{tid};
+        remove(positions);
     }
 
     template <class T>
     void DictionaryCompressedColumn<T>::remove(PositionList &positions)
     {
-        for (auto &tid : positions)
-        {
-            remove(tid);
-        }
+        if (positions.empty())
+            return;
+
+        // remove reference from table with offset tid
+        // we don't remove record from dictionary because if so we would have to shift the table indices
+        // furthermore it's possible that the record is used at another index in table and if not
+        // it's possible it will be used again in the future
+        // all codes behind the first removed row move, so the segments from there on are encoded again
+        size_t first_segment = positions.front() / SEGMENT_SIZE;
+        std::vector<Code> codes = extractFrom(first_segment);
+        for (auto rit = positions.rbegin(); rit != positions.rend(); ++rit)
+            codes.erase(codes.begin() + (*rit - first_segment * SEGMENT_SIZE));
+        for (Code code : codes)
+            appendCode(code);
     }
 
     template <class T>
     void DictionaryCompressedColumn<T>::clearContent()
     {
+        segments.clear();
         table.clear();
         dictionary.clear();
     }
@@ -241,14 +781,53 @@ namespace CoGaDB
     template <class T>
     T DictionaryCompressedColumn<T>::operator[](const int idx)
     {
-        size_t dictIdx = table[idx];
+        size_t dictIdx = codeAt(idx);
         return dictionary[dictIdx];
     }
 
     template <class T>
     size_t DictionaryCompressedColumn<T>::getSizeInBytes() const noexcept
     {
-        return table.size() * sizeof(size_t) + dictionary.size() * sizeof(T);
+        size_t size_in_bytes = table.size() * sizeof(Code) + dictionary.size() * sizeof(T);
+        for (auto const &segment : segments)
+        {
+            size_in_bytes += sizeof(segment.bit_width) +
+                             (segment.headers.size() + segment.run_values.size() + segment.packed.size()) * sizeof(Code);
+        }
+        return size_in_bytes;
+    }
+
+    template <class T>
+    void DictionaryCompressedColumn<T>::decode(const TID begin, const size_t count, T *out)
+    {
+        const size_t end = begin + count, sealed_rows = segments.size() * SEGMENT_SIZE;
+        std::vector<Code> codes(SEGMENT_SIZE);
+        size_t tid = begin;
+        while (tid < std::min(end, sealed_rows))
+        {
+            size_t offset = tid % SEGMENT_SIZE, number_of_rows = std::min(SEGMENT_SIZE - offset, end - tid);
+            decodeSegment(segments[tid / SEGMENT_SIZE], codes.data());
+            for (size_t i = 0; i < number_of_rows; ++i)
+                *out++ = dictionary[codes[offset + i]];
+            tid += number_of_rows;
+        }
+        for (; tid < end; ++tid)
+            *out++ = dictionary[table[tid - sealed_rows]];
+    }
+
+    template <class T>
+    PositionList DictionaryCompressedColumn<T>::selection(const ColumnType &value_for_comparison, const ValueComparator comp)
+    {
+        PositionList result_tids;
+        scan(std::get<T>(value_for_comparison), comp, &result_tids);
+        return result_tids;
+    }
+
+    template <class T>
+    size_t DictionaryCompressedColumn<T>::count(const ColumnType &value_for_comparison, const ValueComparator comp,
+                                                unsigned int)
+    {
+        return scan(std::get<T>(value_for_comparison), comp, nullptr);
     }
 
     /***************** End of Implementation Section ******************/
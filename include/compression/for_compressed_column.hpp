@@ -0,0 +1,224 @@
+#pragma once
+
+#include "bit_packing.hpp"
+#include "block_compressed_column.hpp"
+#include "core/simd_kernels.hpp"
+#include <algorithm>
+#include <array>
+
+namespace CoGaDB
+{
+
+    /*!
+     *  \brief     This class represents the patch policy of plain frame-of-reference coding, which has no exceptions.
+     *  \details   The bit width fits the largest offset of the block, so no offset has to be patched. A patch policy
+     * provides chooseBitWidth, a constructor that collects the exceptions of a block, the patch step after unpacking,
+     * the largest patched high bits, its size and its serialization. It is stored in every block of FORCodec.
+     */
+    struct NoPatches
+    {
+        NoPatches() = default;
+
+        NoPatches(const uint32_t *, unsigned) {}
+
+        // smallest bit width that fits all offsets, given how many offsets need each bit width
+        static unsigned chooseBitWidth(const std::array<size_t, 33> &bit_width_histogram)
+        {
+            unsigned bit_width = 32;
+            while (bit_width > 0 && bit_width_histogram[bit_width] == 0)
+                --bit_width;
+            return bit_width;
+        }
+
+        void patch(uint32_t *, unsigned) const {}
+
+        uint32_t patch(uint32_t offset, size_t, unsigned) const
+        {
+            return offset;
+        }
+
+        uint32_t maxHighBits() const
+        {
+            return 0;
+        }
+
+        size_t sizeInBytes() const
+        {
+            return 0;
+        }
+
+        // nothing is written, so blocks of plain FOR keep their format
+        template <class Archive>
+        void serialize(Archive &)
+        {
+        }
+    };
+
+    /*!
+     *  \brief     This class represents the frame-of-reference coding of blocks of a 32 bit signed integer type T.
+     *  \details   Every block stores its minimum as base and the offsets of its rows to the base, bit-packed with the
+     * bit width that Patches chooses. Offsets that need more bits are patched in by Patches after unpacking, see
+     * PatchList, plain FOR uses NoPatches and packs every offset with the width of the largest one. Selections compare
+     * the offsets against the comparison value shifted into the offset domain of the block, and skip blocks whose offset
+     * range cannot contain (or contains only) qualifying rows.
+     */
+    template <class T, class Patches = NoPatches>
+    struct FORCodec
+    {
+        static_assert(std::is_integral_v<T> && std::is_signed_v<T> && sizeof(T) == sizeof(uint32_t),
+                      "frame-of-reference coding is implemented for 32 bit signed integers");
+
+        static constexpr size_t BLOCK_SIZE = bit_packing::SIMD_BLOCK_SIZE;
+
+        struct Block
+        {
+            T base = 0;                   // minimum of the block
+            uint8_t bit_width = 0;        // bits per packed offset
+            std::vector<uint32_t> packed; // low bits of the BLOCK_SIZE offsets in the layout of bit_packing::pack128
+            Patches patches;              // high bits of the offsets that need more than bit_width bits
+
+            template <class Archive>
+            void serialize(Archive &archive)
+            {
+                archive(base, bit_width, packed, patches);
+            }
+        };
+
+        static Block encodeBlock(const T *values);
+
+        static void decodeBlock(const Block &block, T *values);
+
+        static T decodeRow(const Block &block, size_t i);
+
+        static size_t sizeInBytes(const Block &block);
+
+        // unpacks the offsets of block to the base and patches the exceptions in
+        static void decodeOffsets(const Block &block, uint32_t *offsets);
+
+        // evaluates (row comp value) on all rows of block, appends the qualifying TIDs to result_tids unless it is a
+        // nullptr and returns the number of qualifying rows
+        static size_t scanBlock(const Block &block, T value, ValueComparator comp, TID first_tid,
+                                PositionList *result_tids);
+    };
+
+    /*!
+     *  \brief     This class represents a frame-of-reference compressed column with a 32 bit signed integer type T.
+     */
+    template <class T>
+    using FORCompressedColumn = BlockCompressedColumn<T, FORCodec<T>>;
+
+    /***************** Start of Implementation Section ******************/
+
+    template <class T, class Patches>
+    typename FORCodec<T, Patches>::Block FORCodec<T, Patches>::encodeBlock(const T *values)
+    {
+        Block block;
+        block.base = *std::min_element(values, values + BLOCK_SIZE);
+
+        std::array<uint32_t, BLOCK_SIZE> offsets;
+        std::array<size_t, 33> bit_width_histogram{};
+        for (size_t i = 0; i < BLOCK_SIZE; ++i)
+        {
+            offsets[i] = static_cast<uint32_t>(values[i]) - static_cast<uint32_t>(block.base);
+            bit_width_histogram[bit_packing::required_bit_width(offsets[i])]++;
+        }
+
+        block.bit_width = static_cast<uint8_t>(Patches::chooseBitWidth(bit_width_histogram));
+        block.patches = Patches(offsets.data(), block.bit_width);
+        block.packed.resize(bit_packing::packed_size128(block.bit_width));
+        bit_packing::pack128(offsets.data(), block.bit_width, block.packed.data());
+        return block;
+    }
+
+    template <class T, class Patches>
+    void FORCodec<T, Patches>::decodeOffsets(const Block &block, uint32_t *offsets)
+    {
+        bit_packing::unpack128(block.packed.data(), block.bit_width, offsets);
+        block.patches.patch(offsets, block.bit_width);
+    }
+
+    template <class T, class Patches>
+    void FORCodec<T, Patches>::decodeBlock(const Block &block, T *values)
+    {
+        std::array<uint32_t, BLOCK_SIZE> offsets;
+        decodeOffsets(block, offsets.data());
+        for (size_t i = 0; i < BLOCK_SIZE; ++i)
+            values[i] = static_cast<T>(static_cast<uint32_t>(block.base) + offsets[i]);
+    }
+
+    template <class T, class Patches>
+    T FORCodec<T, Patches>::decodeRow(const Block &block, size_t i)
+    {
+        uint32_t offset = bit_packing::extract128(block.packed.data(), block.bit_width, i);
+        offset = block.patches.patch(offset, i, block.bit_width);
+        return static_cast<T>(static_cast<uint32_t>(block.base) + offset);
+    }
+
+    template <class T, class Patches>
+    size_t FORCodec<T, Patches>::sizeInBytes(const Block &block)
+    {
+        return sizeof(block.base) + sizeof(block.bit_width) + block.packed.size() * sizeof(uint32_t) +
+               block.patches.sizeInBytes();
+    }
+
+    template <class T, class Patches>
+    size_t FORCodec<T, Patches>::scanBlock(const Block &block, const T value, const ValueComparator comp,
+                                           const TID first_tid, PositionList *result_tids)
+    {
+        // the comparison value in the offset domain of the block, all offsets lie in [0, max_offset]
+        const int64_t shifted = static_cast<int64_t>(value) - block.base;
+        const int64_t max_offset = ((int64_t(block.patches.maxHighBits()) + 1) << block.bit_width) - 1;
+
+        bool none = false, all = false;
+        switch (comp)
+        {
+        case EQUAL:
+            none = shifted < 0 || shifted > max_offset;
+            break;
+        case LESSER:
+            none = shifted <= 0;
+            all = shifted > max_offset;
+            break;
+        case GREATER:
+            none = shifted >= max_offset;
+            all = shifted < 0;
+            break;
+        }
+
+        if (none)
+            return 0;
+        if (all)
+        {
+            if (result_tids)
+            {
+                for (TID tid = first_tid; tid < first_tid + BLOCK_SIZE; ++tid)
+                    result_tids->push_back(tid);
+            }
+            return BLOCK_SIZE;
+        }
+
+        // offsets may use all 32 bits, flipping the sign bit turns the unsigned comparison into a signed one
+        constexpr uint32_t sign_bit = uint32_t(1) << 31;
+        std::array<uint32_t, BLOCK_SIZE> offsets;
+        decodeOffsets(block, offsets.data());
+        std::array<int32_t, BLOCK_SIZE> keys;
+        for (size_t i = 0; i < BLOCK_SIZE; ++i)
+            keys[i] = static_cast<int32_t>(offsets[i] ^ sign_bit);
+
+        std::array<uint8_t, BLOCK_SIZE> matches;
+        simd::evaluate_predicate(keys.data(), BLOCK_SIZE, static_cast<int32_t>(static_cast<uint32_t>(shifted) ^ sign_bit),
+                                 comp, matches.data());
+
+        size_t qualifying_rows = 0;
+        for (size_t i = 0; i < BLOCK_SIZE; ++i)
+        {
+            if (matches[i] && result_tids)
+                result_tids->push_back(first_tid + static_cast<TID>(i));
+            qualifying_rows += matches[i];
+        }
+        return qualifying_rows;
+    }
+
+    /***************** End of Implementation Section ******************/
+
+} // namespace CoGaDB
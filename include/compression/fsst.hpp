@@ -0,0 +1,167 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/*! \brief A static symbol table in the style of FSST (fast static symbol table) string compression.
+ *  \details The table holds up to 255 symbols of 1 to 8 bytes. A string is encoded by greedily replacing the longest
+ * symbol that matches at the current position with its 1 byte code. Bytes that start no symbol are written as the
+ * escape code followed by the byte itself. Since the encoding is deterministic, two strings are equal exactly if their
+ * encodings are equal.*/
+namespace CoGaDB::fsst
+{
+
+    constexpr uint8_t ESCAPE_CODE = 255;
+
+    constexpr size_t MAX_SYMBOL_LENGTH = 8;
+
+    constexpr size_t MAX_SYMBOLS = 255;
+
+    class SymbolTable
+    {
+    public:
+        /*! \brief learns the symbols that save the most bytes on the sample strings */
+        static SymbolTable train(const std::vector<std::string> &sample);
+
+        /*! \brief appends the codes of value to codes */
+        void encode(const std::string &value, std::vector<uint8_t> &codes) const;
+
+        /*! \brief decodes the n codes starting at codes */
+        std::string decode(const uint8_t *codes, size_t n) const;
+
+        [[nodiscard]] size_t getSizeInBytes() const noexcept;
+
+        template <class Archive>
+        void serialize(Archive &archive)
+        {
+            archive(symbols);
+            if constexpr (Archive::is_loading::value)
+                buildIndex();
+        }
+
+    private:
+        std::vector<std::string> symbols; // the symbol with code c is symbols[c]
+
+        // codes of all symbols that start with a byte, longest symbols first
+        std::array<std::vector<uint8_t>, 256> index;
+
+        void buildIndex();
+
+        // code and length of the longest symbol that matches value at position, or (ESCAPE_CODE, 1)
+        [[nodiscard]] std::pair<uint8_t, size_t> longestMatch(const std::string &value, size_t position) const;
+    };
+
+    inline void SymbolTable::buildIndex()
+    {
+        for (auto &codes : index)
+            codes.clear();
+        for (size_t code = 0; code < symbols.size(); ++code)
+            index[static_cast<uint8_t>(symbols[code][0])].push_back(static_cast<uint8_t>(code));
+        for (auto &codes : index)
+        {
+            std::stable_sort(codes.begin(), codes.end(),
+                             [this](uint8_t a, uint8_t b) { return symbols[a].size() > symbols[b].size(); });
+        }
+    }
+
+    inline std::pair<uint8_t, size_t> SymbolTable::longestMatch(const std::string &value, const size_t position) const
+    {
+        const size_t remaining = value.size() - position;
+        for (uint8_t code : index[static_cast<uint8_t>(value[position])])
+        {
+            const std::string &symbol = symbols[code];
+            if (symbol.size() <= remaining && std::memcmp(symbol.data(), value.data() + position, symbol.size()) == 0)
+                return {code, symbol.size()};
+        }
+        return {ESCAPE_CODE, 1};
+    }
+
+    inline SymbolTable SymbolTable::train(const std::vector<std::string> &sample)
+    {
+        // every round encodes the sample with the current table and counts how often the symbols and the
+        // concatenations of neighbouring symbols occur, the next table keeps the candidates with the highest gain
+        constexpr size_t NUMBER_OF_ROUNDS = 5;
+
+        SymbolTable table;
+        for (size_t round = 0; round < NUMBER_OF_ROUNDS; ++round)
+        {
+            std::unordered_map<std::string, size_t> frequencies;
+            for (const std::string &value : sample)
+            {
+                std::string previous;
+                for (size_t position = 0; position < value.size();)
+                {
+                    size_t length = table.longestMatch(value, position).second;
+                    std::string current = value.substr(position, length);
+
+                    frequencies[current]++;
+                    if (length > 1)
+                        frequencies[value.substr(position, 1)]++;
+                    if (!previous.empty() && previous.size() + current.size() <= MAX_SYMBOL_LENGTH)
+                        frequencies[previous + current]++;
+
+                    previous = std::move(current);
+                    position += length;
+                }
+            }
+
+            std::vector<std::pair<size_t, std::string>> candidates;
+            candidates.reserve(frequencies.size());
+            for (auto &[candidate, frequency] : frequencies)
+                candidates.emplace_back(frequency * candidate.size(), candidate);
+            size_t number_of_symbols = std::min(candidates.size(), MAX_SYMBOLS);
+            std::partial_sort(candidates.begin(), candidates.begin() + number_of_symbols, candidates.end(),
+                              [](const auto &a, const auto &b) {
+                                  return a.first != b.first ? a.first > b.first : a.second < b.second;
+                              });
+
+            table.symbols.clear();
+            for (size_t i = 0; i < number_of_symbols; ++i)
+                table.symbols.push_back(std::move(candidates[i].second));
+            table.buildIndex();
+        }
+        return table;
+    }
+
+    inline void SymbolTable::encode(const std::string &value, std::vector<uint8_t> &codes) const
+    {
+        for (size_t position = 0; position < value.size();)
+        {
+            auto [code, length] = longestMatch(value, position);
+            codes.push_back(code);
+            if (code == ESCAPE_CODE)
+                codes.push_back(static_cast<uint8_t>(value[position]));
+            position += length;
+        }
+    }
+
+    inline std::string SymbolTable::decode(const uint8_t *codes, const size_t n) const
+    {
+        std::string value;
+        value.reserve(n * 2);
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (codes[i] == ESCAPE_CODE)
+                value.push_back(static_cast<char>(codes[++i]));
+            else
+                value += symbols[codes[i]];
+        }
+        return value;
+    }
+
+    inline size_t SymbolTable::getSizeInBytes() const noexcept
+    {
+        size_t size = 0;
+        for (auto const &symbol : symbols)
+            size += symbol.size() + 1;
+        return size;
+    }
+
+} // namespace CoGaDB::fsst
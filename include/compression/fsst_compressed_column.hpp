@@ -0,0 +1,370 @@
+#pragma once
+
+#include "compressed_column.hpp"
+#include "core/global_definitions.hpp"
+#include "core/predicate.hpp"
+#include "fsst.hpp"
+#include <cereal/archives/portable_binary.hpp>
+#include <cereal/types/string.hpp>
+#include <cereal/types/vector.hpp>
+#include <cstring>
+#include <iterator>
+#include <sstream>
+
+namespace CoGaDB
+{
+
+    /*!
+     *  \brief     This class represents a string column compressed with a static symbol table, see fsst.hpp.
+     *  \details   The first TRAINING_ROWS rows are kept uncompressed. Once they are complete, the symbol table is
+     * trained on them and all rows are encoded as sequences of 1 byte codes, which are stored back to back with the
+     * offset of every row. The table stays fixed from then on. Unlike DictionaryCompressedColumn this also compresses
+     * columns in which almost every value is unique, as long as the values share frequent substrings (URLs, log
+     * messages, ...). Accessing a row decodes only that row, and equality selections compare the encoded rows with the
+     * encoded comparison value without decoding.
+     */
+    template <class T>
+    class FSSTCompressedColumn final : public CompressedColumn<T>
+    {
+        static_assert(std::is_same_v<T, std::string>, "symbol table compression is implemented for strings");
+
+    public:
+        /***************** constructors and destructor *****************/
+        explicit FSSTCompressedColumn(const std::string &name);
+
+        ~FSSTCompressedColumn() final;
+
+        void insert(const ColumnType &new_Value) final;
+
+        void insert(const T &new_value) final;
+
+        template <typename InputIterator>
+        void insert(InputIterator first, InputIterator last);
+
+        void update(TID tid, const ColumnType &new_value) final;
+
+        void update(PositionList &tid, const ColumnType &new_value) final;
+
+        void remove(TID tid) final;
+
+        // assumes tid list is sorted ascending
+        void remove(PositionList &tid) final;
+
+        void clearContent() final;
+
+        ColumnType get(TID tid) final;
+
+        std::string print() const noexcept final;
+
+        [[nodiscard]] size_t size() const noexcept final;
+
+        [[nodiscard]] size_t getSizeInBytes() const noexcept final;
+
+        [[nodiscard]] std::unique_ptr<ColumnBase> copy() const final;
+
+        void store(const std::string &path) final;
+        void load(const std::string &path) final;
+
+        T operator[](int idx) final;
+
+        /*! \brief compares the encoded rows for EQUAL, decodes the rows for LESSER and GREATER */
+        PositionList selection(const ColumnType &value_for_comparison, ValueComparator comp) final;
+
+        size_t count(const ColumnType &value_for_comparison,
+                     ValueComparator comp,
+                     unsigned int number_of_threads = 1) final;
+
+        /**
+         * @brief Serialization method called by Cereal. Implement this method in your compressed columns to get serialization working.
+         */
+        template <class Archive>
+        void serialize(Archive &archive)
+        {
+            archive(trained, symbol_table, pending, codes, offsets);
+        }
+
+    private:
+        // number of rows the symbol table is trained on
+        static constexpr size_t TRAINING_ROWS = 256;
+
+        bool trained;
+        fsst::SymbolTable symbol_table;
+        std::vector<T> pending;      // all rows as long as the symbol table is not trained
+        std::vector<uint8_t> codes;  // codes of all rows back to back once the symbol table is trained
+        std::vector<uint32_t> offsets; // row i is encoded in codes[offsets[i], offsets[i + 1])
+
+        void train();
+
+        // evaluates (row comp value) on all rows, appends the qualifying TIDs to result_tids unless it is a nullptr and
+        // returns the number of qualifying rows
+        size_t scan(const T &value, ValueComparator comp, PositionList *result_tids) const;
+    };
+
+    /***************** Start of Implementation Section ******************/
+
+    template <class T>
+    FSSTCompressedColumn<T>::FSSTCompressedColumn(const std::string &name)
+        : CompressedColumn<T>(name), trained(false), symbol_table(), pending(), codes(), offsets() {}
+
+    template <class T>
+    FSSTCompressedColumn<T>::~FSSTCompressedColumn() = default;
+
+    template <class T>
+    void FSSTCompressedColumn<T>::train()
+    {
+        symbol_table = fsst::SymbolTable::train(pending);
+        trained = true;
+
+        offsets.assign(1, 0);
+        for (const T &value : pending)
+        {
+            symbol_table.encode(value, codes);
+            offsets.push_back(static_cast<uint32_t>(codes.size()));
+        }
+        pending.clear();
+        pending.shrink_to_fit();
+    }
+
+    template <class T>
+    size_t FSSTCompressedColumn<T>::scan(const T &value, const ValueComparator comp, PositionList *result_tids) const
+    {
+        size_t qualifying_rows = 0;
+        auto add = [&](TID tid) {
+            if (result_tids)
+                result_tids->push_back(tid);
+            qualifying_rows++;
+        };
+
+        // the comparator is dispatched once, the loops are instantiated for every comparator
+        with_predicate(comp, [&](auto predicate) {
+            if (!trained)
+            {
+                for (size_t tid = 0; tid < pending.size(); ++tid)
+                {
+                    if (predicate(pending[tid], value))
+                        add(static_cast<TID>(tid));
+                }
+            }
+            else if constexpr (decltype(predicate)::comparator == EQUAL)
+            {
+                std::vector<uint8_t> encoded_value;
+                symbol_table.encode(value, encoded_value);
+                for (size_t tid = 0; tid + 1 < offsets.size(); ++tid)
+                {
+                    size_t length = offsets[tid + 1] - offsets[tid];
+                    if (length == encoded_value.size() &&
+                        std::memcmp(codes.data() + offsets[tid], encoded_value.data(), length) == 0)
+                        add(static_cast<TID>(tid));
+                }
+            }
+            else
+            {
+                for (size_t tid = 0; tid + 1 < offsets.size(); ++tid)
+                {
+                    if (predicate(symbol_table.decode(codes.data() + offsets[tid], offsets[tid + 1] - offsets[tid]), value))
+                        add(static_cast<TID>(tid));
+                }
+            }
+        });
+        return qualifying_rows;
+    }
+
+    template <class T>
+    void FSSTCompressedColumn<T>::insert(const ColumnType &new_value)
+    {
+        insert(std::get<T>(new_value));
+    }
+
+    template <class T>
+    void FSSTCompressedColumn<T>::insert(const T &new_value)
+    {
+        if (trained)
+        {
+            symbol_table.encode(new_value, codes);
+            offsets.push_back(static_cast<uint32_t>(codes.size()));
+            return;
+        }
+
+        pending.push_back(new_value);
+        if (pending.size() == TRAINING_ROWS)
+            train();
+    }
+
+    template <typename T>
+    template <typename InputIterator>
+    void FSSTCompressedColumn<T>::insert(InputIterator first, InputIterator last)
+    {
+        for (InputIterator i = first; i < last; ++i)
+        {
+            insert(*i);
+        }
+    }
+
+    template <class T>
+    void FSSTCompressedColumn<T>::update(TID tid, const ColumnType &new_value)
+    {
+        const T &value = std::get<T>(new_value);
+        if (!trained)
+        {
+            pending[tid] = value;
+            return;
+        }
+
+        std::vector<uint8_t> encoded_value;
+        symbol_table.encode(value, encoded_value);
+
+        // the codes of all following rows move by the difference in length
+        int64_t shift = static_cast<int64_t>(encoded_value.size()) - (offsets[tid + 1] - offsets[tid]);
+        codes.erase(codes.begin() + offsets[tid], codes.begin() + offsets[tid + 1]);
+        codes.insert(codes.begin() + offsets[tid], encoded_value.begin(), encoded_value.end());
+        for (size_t i = tid + 1; i < offsets.size(); ++i)
+            offsets[i] = static_cast<uint32_t>(offsets[i] + shift);
+    }
+
+    template <class T>
+    void FSSTCompressedColumn<T>::update(PositionList &positions, const ColumnType &new_value)
+    {
+        for (auto &tid : positions)
+        {
+            update(tid, new_value);
+        }
+    }
+
+    template <class T>
+    void FSSTCompressedColumn<T>::remove(TID tid)
+    {
+        PositionList positions{tid};
+        remove(positions);
+    }
+
+    template <class T>
+    void FSSTCompressedColumn<T>::remove(PositionList &positions)
+    {
+        if (!trained)
+        {
+            for (auto rit = positions.rbegin(); rit != positions.rend(); ++rit)
+                pending.erase(pending.begin() + *rit);
+            return;
+        }
+
+        // compacts the codes and offsets of the remaining rows in a single pass
+        size_t removed = 0, write = offsets[positions.empty() ? 0 : positions.front()];
+        for (size_t tid = positions.empty() ? offsets.size() : positions.front(); tid + 1 < offsets.size(); ++tid)
+        {
+            uint32_t begin = offsets[tid], end = offsets[tid + 1];
+            if (removed < positions.size() && positions[removed] == tid)
+            {
+                removed++;
+                continue;
+            }
+            std::memmove(codes.data() + write, codes.data() + begin, end - begin);
+            offsets[tid + 1 - removed] = static_cast<uint32_t>(write + (end - begin));
+            write += end - begin;
+        }
+        if (!positions.empty())
+        {
+            codes.resize(write);
+            offsets.resize(offsets.size() - positions.size());
+        }
+    }
+
+    template <class T>
+    void FSSTCompressedColumn<T>::clearContent()
+    {
+        trained = false;
+        symbol_table = fsst::SymbolTable();
+        pending.clear();
+        codes.clear();
+        offsets.clear();
+    }
+
+    template <class T>
+    ColumnType FSSTCompressedColumn<T>::get(TID tid)
+    {
+        return {operator[](tid)};
+    }
+
+    template <class T>
+    std::string FSSTCompressedColumn<T>::print() const noexcept
+    {
+        std::stringstream output;
+
+        output << this->name_ << "(" << size() << ")" << std::endl;
+        for (auto const &row : pending)
+            output << "\t" << row << std::endl;
+        for (size_t tid = 0; tid + 1 < offsets.size(); ++tid)
+            output << "\t" << symbol_table.decode(codes.data() + offsets[tid], offsets[tid + 1] - offsets[tid]) << std::endl;
+
+        return output.str();
+    }
+
+    template <class T>
+    size_t FSSTCompressedColumn<T>::size() const noexcept
+    {
+        return trained ? offsets.size() - 1 : pending.size();
+    }
+
+    template <class T>
+    size_t FSSTCompressedColumn<T>::getSizeInBytes() const noexcept
+    {
+        size_t size_in_bytes = symbol_table.getSizeInBytes() + codes.size() + offsets.size() * sizeof(uint32_t);
+        for (auto const &row : pending)
+            size_in_bytes += row.size();
+        return size_in_bytes;
+    }
+
+    template <class T>
+    std::unique_ptr<ColumnBase> FSSTCompressedColumn<T>::copy() const
+    {
+        return std::make_unique<FSSTCompressedColumn<T>>(*this);
+    }
+
+    template <class T>
+    void FSSTCompressedColumn<T>::store(const std::string &path_)
+    {
+        std::string path(path_);
+        path += this->name_;
+
+        std::ofstream outfile(path.c_str(), std::ofstream::binary | std::ofstream::out | std::ofstream::trunc);
+        assert(outfile.is_open());
+        cereal::PortableBinaryOutputArchive oarchive(outfile);
+        oarchive(*this);
+    }
+
+    template <class T>
+    void FSSTCompressedColumn<T>::load(const std::string &path_)
+    {
+        std::string path(path_);
+        path += this->name_;
+
+        std::ifstream infile(path.c_str(), std::ifstream::binary | std::ifstream::in);
+        cereal::PortableBinaryInputArchive ia(infile);
+        ia(*this);
+    }
+
+    template <class T>
+    T FSSTCompressedColumn<T>::operator[](const int idx)
+    {
+        if (!trained)
+            return pending[idx];
+        return symbol_table.decode(codes.data() + offsets[idx], offsets[idx + 1] - offsets[idx]);
+    }
+
+    template <class T>
+    PositionList FSSTCompressedColumn<T>::selection(const ColumnType &value_for_comparison, const ValueComparator comp)
+    {
+        PositionList result_tids;
+        scan(std::get<T>(value_for_comparison), comp, &result_tids);
+        return result_tids;
+    }
+
+    template <class T>
+    size_t FSSTCompressedColumn<T>::count(const ColumnType &value_for_comparison, const ValueComparator comp,
+                                          unsigned int)
+    {
+        return scan(std::get<T>(value_for_comparison), comp, nullptr);
+    }
+
+    /***************** End of Implementation Section ******************/
+
+} // namespace CoGaDB
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "bit_packing.hpp"
+#include "for_compressed_column.hpp"
+#include <algorithm>
+#include <array>
+
+namespace CoGaDB
+{
+
+    /*!
+     *  \brief     This class represents the patch policy of patched frame-of-reference (PFOR) coding.
+     *  \details   The bit width is not chosen to fit the largest offset of the block: offsets that need more bits become
+     * exceptions, whose packed slot keeps the low bits and whose high bits are stored in the patch list next to their
+     * position in the block. The bit width with the smallest encoded size is picked, so a few outliers no longer force
+     * the whole block to a wide bit width. The exceptions are patched in after unpacking.
+     */
+    struct PatchList
+    {
+        PatchList() = default;
+
+        // collects the offsets of a block that need more than bit_width bits
+        PatchList(const uint32_t *offsets, unsigned bit_width);
+
+        // bit width with the smallest encoded size of the block, given how many offsets need each bit width
+        static unsigned chooseBitWidth(const std::array<size_t, 33> &bit_width_histogram);
+
+        // adds the high bits of the exceptions to the unpacked offsets of the block
+        void patch(uint32_t *offsets, unsigned bit_width) const;
+
+        // adds the high bits to the unpacked offset of the row i of the block if it is an exception
+        uint32_t patch(uint32_t offset, size_t i, unsigned bit_width) const;
+
+        uint32_t maxHighBits() const;
+
+        size_t sizeInBytes() const;
+
+        template <class Archive>
+        void serialize(Archive &archive)
+        {
+            archive(positions, values);
+        }
+
+        std::vector<uint8_t> positions; // ascending positions of the offsets that need more bits
+        std::vector<uint32_t> values;   // offset >> bit_width of every exception
+    };
+
+    /*!
+     *  \brief     This class represents a patched frame-of-reference (PFOR) compressed column with a 32 bit signed
+     * integer type T.
+     */
+    template <class T>
+    using PatchedFORCompressedColumn = BlockCompressedColumn<T, FORCodec<T, PatchList>>;
+
+    /***************** Start of Implementation Section ******************/
+
+    inline PatchList::PatchList(const uint32_t *offsets, const unsigned bit_width)
+    {
+        for (size_t i = 0; i < bit_packing::SIMD_BLOCK_SIZE; ++i)
+        {
+            if (bit_packing::required_bit_width(offsets[i]) > bit_width)
+            {
+                positions.push_back(static_cast<uint8_t>(i));
+                values.push_back(offsets[i] >> bit_width);
+            }
+        }
+    }
+
+    inline unsigned PatchList::chooseBitWidth(const std::array<size_t, 33> &bit_width_histogram)
+    {
+        // every exception costs its position and its high bits on top of its packed slot
+        constexpr size_t exception_bits = 8 * (sizeof(uint8_t) + sizeof(uint32_t));
+        constexpr size_t block_size = bit_packing::SIMD_BLOCK_SIZE;
+
+        unsigned best_bit_width = 32;
+        size_t best_cost = block_size * 32, exceptions = 0;
+        for (unsigned bit_width = 32; bit_width-- > 0;)
+        {
+            exceptions += bit_width_histogram[bit_width + 1];
+            size_t cost = block_size * bit_width + exceptions * exception_bits;
+            if (cost < best_cost)
+            {
+                best_bit_width = bit_width;
+                best_cost = cost;
+            }
+        }
+        return best_bit_width;
+    }
+
+    inline void PatchList::patch(uint32_t *offsets, const unsigned bit_width) const
+    {
+        for (size_t i = 0; i < positions.size(); ++i)
+            offsets[positions[i]] |= values[i] << bit_width;
+    }
+
+    inline uint32_t PatchList::patch(const uint32_t offset, const size_t i, const unsigned bit_width) const
+    {
+        auto exception = std::lower_bound(positions.begin(), positions.end(), i);
+        if (exception != positions.end() && *exception == i)
+            return offset | (values[exception - positions.begin()] << bit_width);
+        return offset;
+    }
+
+    inline uint32_t PatchList::maxHighBits() const
+    {
+        return values.empty() ? 0 : *std::max_element(values.begin(), values.end());
+    }
+
+    inline size_t PatchList::sizeInBytes() const
+    {
+        return positions.size() * (sizeof(uint8_t) + sizeof(uint32_t));
+    }
+
+    /***************** End of Implementation Section ******************/
+
+} // namespace CoGaDB
@@ -8,23 +8,31 @@
 
 #include "compressed_column.hpp"
 #include "core/global_definitions.hpp"
+#include "core/parallel.hpp"
+#include "core/simd_kernels.hpp"
 #include <cereal/archives/portable_binary.hpp>
 #include <cereal/types/string.hpp>
 #include <cereal/types/utility.hpp>
 #include <cereal/types/vector.hpp>
+#include <atomic>
 #include <iterator>
+#include <numeric>
 
 namespace CoGaDB
 {
 
     /*!
-     *  \brief     This class represents a dictionary compressed column with type T, is the base class for all
-     * compressed typed column classes.
+     *  \brief     This class represents a run length encoded column with type T.
+     *  \details   The runs are stored as struct of arrays: one array with the run lengths and one with the run values,
+     * so that kernels can load either of them contiguously into vector registers.
      */
     template <class T>
     class RLECompressedColumn final : public CompressedColumn<T>
     {
     public:
+        /*! \brief a range of consecutive TIDs, given by its first TID and its number of rows */
+        using TIDRange = std::pair<TID, size_t>;
+
         /***************** constructors and destructor *****************/
         explicit RLECompressedColumn(const std::string &name);
 
@@ -33,8 +41,12 @@ namespace CoGaDB
         void insert(const ColumnType &new_Value) final;
         void insert(const T &new_value) final;
 
+        /*! \brief appends the values [first, last)
+         *  \details Contiguous ranges of int or float values are encoded in bulk: run boundaries are found with SIMD
+         * compares of adjacent values, and large inputs are split into chunks that are encoded by up to
+         * number_of_threads threads.*/
         template <typename InputIterator>
-        void insert(InputIterator first, InputIterator last);
+        void insert(InputIterator first, InputIterator last, unsigned int number_of_threads = 1);
 
         void update(TID tid, const ColumnType &new_value) final;
 
@@ -63,27 +75,185 @@ namespace CoGaDB
 
         T operator[](int idx) final;
 
+        /*! \brief finds the run of begin once and expands the runs from there
+         *  \details The search starts at the run where the previous call stopped, so decoding the column vector by
+         * vector walks over every run only once.*/
+        void decode(TID begin, size_t count, T *out) final;
+
+        /*! \brief evaluates the predicate once per run and emits the TIDs of all qualifying runs */
+        PositionList selection(const ColumnType &value_for_comparison, ValueComparator comp) final;
+
+        /*! \brief splits the runs into chunks with about the same number of rows, which are scanned in parallel
+         *  \details The chunk boundaries come from the prefix sum of the run lengths, which also gives every worker
+         * the global TIDs of its runs. Each worker writes its TIDs directly to its part of the result.*/
+        PositionList parallel_selection(const ColumnType &value_for_comparison,
+                                        ValueComparator comp,
+                                        unsigned int number_of_threads) final;
+
+        /*! \brief sums up the lengths of the qualifying runs, using the same parallel scan as parallel_selection */
+        size_t count(const ColumnType &value_for_comparison,
+                     ValueComparator comp,
+                     unsigned int number_of_threads = 1) final;
+
+        /*! \brief sorts the runs instead of the rows, yields the same PositionList as ColumnBaseTyped<T>::sort */
+        PositionList sort(SortOrder order, unsigned int number_of_threads = 1) final;
+
+        /*! \brief selects the first k runs in the order of sortRuns, which hold at least k rows, and expands them */
+        PositionList topK(size_t k, SortOrder order = ASCENDING, unsigned int number_of_threads = 1) final;
+
+        /*! \brief sorts the column and returns the result as RLE compressed position description
+         *  \details Expanding the ranges in order yields sort(order). For ASCENDING a range is enumerated from its
+         * first to its last TID, for DESCENDING from its last down to its first TID.*/
+        std::vector<TIDRange> sortRuns(SortOrder order);
+
+        /*! \brief the arithmetic operations map over the run values, the run lengths stay untouched */
+        bool add(const ColumnType &new_value) final;
+
+        /*! \brief the arithmetic operations between columns align the runs of both inputs if they are RLE compressed */
+        bool add(ColumnBase &column) final;
+
+        bool minus(const ColumnType &new_value) final;
+
+        bool minus(ColumnBase &column) final;
+
+        bool multiply(const ColumnType &new_value) final;
+
+        bool multiply(ColumnBase &column) final;
+
+        bool division(const ColumnType &new_value) final;
+
+        bool division(ColumnBase &column) final;
+
         /**
          * @brief Serialization method called by Cereal. Implement this method in your compressed columns to get serialization working.
+         * @details The format starts with a marker and a version number. Files written before the runs were stored as
+         * struct of arrays start with the length of the vector of (length, value) pairs instead and are still loaded.
          */
         template <class Archive>
         void serialize(Archive &archive)
         {
-            archive(values); // serialize things by passing them to the archive
+            if constexpr (Archive::is_loading::value)
+            {
+                cursor.reset();
+                uint64_t header = 0;
+                archive(header);
+                if (header == FORMAT_MARKER)
+                {
+                    uint32_t version = 0;
+                    archive(version);
+                    if (version != FORMAT_VERSION)
+                        throw cereal::Exception("unsupported RLE column format version " + std::to_string(version));
+                    archive(run_lengths, run_values);
+                }
+                else
+                {
+                    // legacy format, header is the number of (length, value) pairs
+                    run_lengths.resize(header);
+                    run_values.resize(header);
+                    for (uint64_t i = 0; i < header; ++i)
+                        archive(run_lengths[i], run_values[i]);
+                }
+            }
+            else
+            {
+                archive(FORMAT_MARKER, FORMAT_VERSION, run_lengths, run_values);
+            }
         }
 
     private:
-        typedef std::pair<uint8_t, T> Item; // Pair of counter and Value that is counted
+        static constexpr uint64_t FORMAT_MARKER = UINT64_MAX;
+        static constexpr uint32_t FORMAT_VERSION = 1;
+
+        static constexpr size_t MAX_RUN_LENGTH = UINT8_MAX - 1;
+        // inputs are split into chunks of at least this many rows for the parallel bulk encoding
+        static constexpr size_t PARALLEL_CHUNK_SIZE = 1 << 16;
+
+        template <typename InputIterator>
+        static constexpr bool is_contiguous_numeric =
+            (std::is_same_v<T, int> || std::is_same_v<T, float>) &&
+            (std::is_pointer_v<InputIterator> || std::is_same_v<InputIterator, typename std::vector<T>::iterator> ||
+             std::is_same_v<InputIterator, typename std::vector<T>::const_iterator>);
 
-        std::vector<Item> values; // Vector of pairs
+        // booleans are stored as bytes, std::vector<bool> is a bitset without contiguous storage
+        using RunValue = std::conditional_t<std::is_same_v<T, bool>, uint8_t, T>;
+
+        std::vector<uint8_t> run_lengths; // number of rows of every run
+        std::vector<RunValue> run_values; // value of every run
+
+        // the run where the last decode stopped together with the TID of its first row, packed into one word, so that
+        // concurrent calls of decode read and write it without a lock
+        class RunCursor
+        {
+        public:
+            RunCursor() = default;
+            RunCursor(const RunCursor &other) : packed(other.packed.load(std::memory_order_relaxed)) {}
+            RunCursor &operator=(const RunCursor &other)
+            {
+                packed.store(other.packed.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                return *this;
+            }
+
+            void load(size_t &run, size_t &run_start) const
+            {
+                uint64_t value = packed.load(std::memory_order_relaxed);
+                run = value >> 32;
+                run_start = value & UINT32_MAX;
+            }
+
+            void store(size_t run, size_t run_start)
+            {
+                if (run <= UINT32_MAX)
+                    packed.store(static_cast<uint64_t>(run) << 32 | run_start, std::memory_order_relaxed);
+            }
+
+            // has to be called whenever runs are inserted, removed or resized in front of the end of the column
+            void reset() { packed.store(0, std::memory_order_relaxed); }
+
+        private:
+            std::atomic<uint64_t> packed{0};
+        };
+
+        RunCursor cursor;
+
+        // index of the run that holds tid together with the TID of its first row
+        void findRun(TID tid, size_t &run, size_t &run_start) const;
+
+        // intermediate results of a parallel scan over the runs
+        struct RunScan
+        {
+            std::vector<TID> run_starts;   // TID of the first row of every run
+            std::vector<size_t> chunks;    // index of the first run of every chunk, followed by the number of runs
+            std::vector<uint8_t> matches;  // 1 for every run that fulfills the predicate
+            std::vector<size_t> offsets;   // number of qualifying rows before every chunk, followed by the total
+        };
+
+        // evaluates the predicate on all runs in parallel and counts the qualifying rows of every chunk
+        void scanRuns(const ColumnType &value_for_comparison, ValueComparator comp, unsigned int number_of_threads, RunScan &scan);
+
+        // indexes of all runs that hold at least one row
+        std::vector<size_t> nonEmptyRuns() const;
 
         void tid_to_idx(TID tid, size_t &idx_of_run, size_t &idx_in_run);
+
+        void insertBulk(const T *data, size_t n, unsigned int number_of_threads);
+
+        // encodes n values into runs, the first run is not merged with any previous run
+        static void encodeRuns(const T *data, size_t n, std::vector<uint8_t> &lengths, std::vector<RunValue> &values);
+
+        template <class Operation>
+        bool mapRuns(const ColumnType &value, Operation op);
+
+        template <class Operation>
+        bool zipRuns(ColumnBase &column, Operation op);
+
+        // appends a run and merges it with the last run if both hold the same value
+        static void appendRun(std::vector<uint8_t> &lengths, std::vector<RunValue> &values, size_t length, const T &value);
     };
 
     /***************** Start of Implementation Section ******************/
 
     template <class T>
-    RLECompressedColumn<T>::RLECompressedColumn(const std::string &name) : CompressedColumn<T>(name), values() {}
+    RLECompressedColumn<T>::RLECompressedColumn(const std::string &name) : CompressedColumn<T>(name), run_lengths(), run_values(), cursor() {}
 
     template <class T>
     RLECompressedColumn<T>::~RLECompressedColumn() = default;
@@ -98,29 +268,95 @@ namespace CoGaDB
     template <class T>
     void RLECompressedColumn<T>::insert(const T &new_value)
     {
-        size_t length = values.size();
+        size_t length = run_values.size();
 
         if (length > 0)
         {
-            Item &most_recent_value = values[length - 1];
-            if (most_recent_value.second == new_value && most_recent_value.first < UINT8_MAX - 1)
+            if (run_values[length - 1] == new_value && run_lengths[length - 1] < MAX_RUN_LENGTH)
             {
-                most_recent_value.first++;
+                run_lengths[length - 1]++;
                 return;
             }
         }
 
-        values.push_back(std::make_pair(1, new_value));
+        run_lengths.push_back(1);
+        run_values.push_back(new_value);
     }
 
     template <typename T>
     template <typename InputIterator>
-    void RLECompressedColumn<T>::insert(InputIterator start, InputIterator end)
+    void RLECompressedColumn<T>::insert(InputIterator start, InputIterator end, unsigned int number_of_threads)
+    {
+        if constexpr (is_contiguous_numeric<InputIterator>)
+        {
+            if (start < end)
+                insertBulk(&*start, end - start, number_of_threads);
+        }
+        else
+        {
+            for (InputIterator i = start; i < end; ++i)
+            {
+                insert(*i);
+            }
+        }
+    }
+
+    template <class T>
+    void RLECompressedColumn<T>::insertBulk(const T *data, size_t n, unsigned int number_of_threads)
+    {
+        size_t number_of_chunks = std::max<size_t>(1, std::min<size_t>(number_of_threads, n / PARALLEL_CHUNK_SIZE));
+        size_t chunk_size = (n + number_of_chunks - 1) / number_of_chunks;
+
+        std::vector<std::vector<uint8_t>> chunk_lengths(number_of_chunks);
+        std::vector<std::vector<RunValue>> chunk_values(number_of_chunks);
+        parallel_for(number_of_chunks, [&](size_t chunk)
+        {
+            size_t begin = chunk * chunk_size;
+            size_t end = std::min(n, begin + chunk_size);
+            encodeRuns(data + begin, end - begin, chunk_lengths[chunk], chunk_values[chunk]);
+        });
+
+        // stitch the chunks together, a run crossing a chunk edge is merged with the last run so far
+        for (size_t chunk = 0; chunk < number_of_chunks; ++chunk)
+        {
+            auto &lengths = chunk_lengths[chunk];
+            auto &values = chunk_values[chunk];
+            if (lengths.empty())
+                continue;
+
+            // the first run of a chunk may have been split into several runs of the maximum length
+            size_t leading_runs = 1, first_run_length = lengths[0];
+            for (; leading_runs < lengths.size() && values[leading_runs] == values[0]; ++leading_runs)
+                first_run_length += lengths[leading_runs];
+
+            appendRun(run_lengths, run_values, first_run_length, values[0]);
+            run_lengths.insert(run_lengths.end(), lengths.begin() + leading_runs, lengths.end());
+            run_values.insert(run_values.end(), values.begin() + leading_runs, values.end());
+        }
+    }
+
+    template <class T>
+    void RLECompressedColumn<T>::encodeRuns(const T *data, size_t n, std::vector<uint8_t> &lengths, std::vector<RunValue> &values)
     {
-        for (InputIterator i = start; i < end; ++i)
+        constexpr size_t BLOCK_SIZE = 4096;
+        std::vector<uint32_t> boundaries(BLOCK_SIZE);
+
+        size_t run_start = 0;
+        auto emit_run = [&](size_t run_end)
         {
-            insert(*i);
+            if (run_end > run_start)
+                appendRun(lengths, values, run_end - run_start, data[run_start]);
+            run_start = run_end;
+        };
+
+        // consecutive blocks overlap by one value, so that every pair of neighbours is compared exactly once
+        for (size_t block = 0; block < n; block += BLOCK_SIZE)
+        {
+            size_t count = simd::find_run_boundaries(data + block, std::min(BLOCK_SIZE + 1, n - block), boundaries.data());
+            for (size_t i = 0; i < count; ++i)
+                emit_run(block + boundaries[i]);
         }
+        emit_run(n);
     }
 
     template <class T>
@@ -135,10 +371,10 @@ namespace CoGaDB
         std::stringstream output;
 
         output << this->name_ << "(" << size() << ")" << std::endl;
-        for (auto const &pair : values)
+        for (size_t run = 0; run < run_values.size(); ++run)
         {
-            for (size_t i = 0; i < pair.first; ++i)
-                output << pair.second << std::endl;
+            for (size_t i = 0; i < run_lengths[run]; ++i)
+                output << static_cast<T>(run_values[run]) << std::endl;
         }
 
         return output.str();
@@ -147,10 +383,7 @@ namespace CoGaDB
     template <class T>
     size_t RLECompressedColumn<T>::size() const noexcept
     {
-        uint64_t size = 0;
-        for (auto const &pair : values)
-            size += pair.first;
-        return size;
+        return simd::sum_run_lengths(run_lengths.data(), run_lengths.size());
     }
 
     template <class T>
@@ -160,63 +393,67 @@ namespace CoGaDB
     }
 
     template <class T>
-    void RLECompressedColumn<T>::tid_to_idx(TID tid, size_t &idx_pair, size_t &idx_str)
+    void RLECompressedColumn<T>::tid_to_idx(TID tid, size_t &idx_run, size_t &idx_in_run)
     {
         TID counter_of_checked_values = 0;
-        size_t len = values.size();
+        size_t len = run_lengths.size();
 
-        while (counter_of_checked_values <= tid && idx_pair < len)
+        while (counter_of_checked_values <= tid && idx_run < len)
         {
-            Item &cur = values[idx_pair];              // current pair
-            idx_str = tid - counter_of_checked_values; // subtract
+            idx_in_run = tid - counter_of_checked_values;
 
-            if (idx_str < cur.first)
+            if (idx_in_run < run_lengths[idx_run])
                 break;
             else
-                counter_of_checked_values += values[idx_pair++].first; // increment by the size of the counter of current pair & increment index of current pair
+                counter_of_checked_values += run_lengths[idx_run++]; // skip the current run
         }
     }
 
     template <class T>
     void RLECompressedColumn<T>::update(TID tid, const ColumnType &new_value)
     {
-        size_t idx_pair = 0, idx_str = 0;
+        size_t idx_run = 0, idx_in_run = 0;
 
-        // get index of pair and index of value in pair
-        tid_to_idx(tid, idx_pair, idx_str);
-
-        auto &entry = values[idx_pair];
+        // get index of run and index of value in run
+        tid_to_idx(tid, idx_run, idx_in_run);
+        cursor.reset();
 
         auto val = std::get<T>(new_value);
-        if (entry.first == 1)
+        uint8_t length = run_lengths[idx_run];
+        if (length == 1)
         {
             // value only occurs once, can be replaced without problems
-            entry.second = val;
+            run_values[idx_run] = val;
         }
-        else if (idx_str == 0)
+        else if (idx_in_run == 0)
         {
             // Updating part of a run decreases its length AAAABBBCCCC
             // leading value needs to be replaced
-            // insert before pair {4, A}; {3, B}; {4, C}   TID=6, tid_of_run_start=4
-            entry.first--;
-            values.insert(values.begin() + idx_pair, std::make_pair(1, val));
+            // insert before run {4, A}; {3, B}; {4, C}   TID=6, tid_of_run_start=4
+            run_lengths[idx_run]--;
+            run_lengths.insert(run_lengths.begin() + idx_run, 1);
+            run_values.insert(run_values.begin() + idx_run, val);
         }
-        else if (idx_str == entry.first)
+        else if (idx_in_run == length - 1u)
         {
             // trailing value needs to be replaced
-            // insert after pair
-            entry.first--;
-            values.insert(values.begin() + idx_pair + 1, std::make_pair(1, val));
+            // insert after run
+            run_lengths[idx_run]--;
+            run_lengths.insert(run_lengths.begin() + idx_run + 1, 1);
+            run_values.insert(run_values.begin() + idx_run + 1, val);
         }
         else
         {
-            // value inside of string needs to be replaced
-            // split pair, insert inbetween
-            uint8_t len_a = idx_str, len_b = entry.first - len_a - 1;
-
-            entry.first = len_a;
-            std::vector<Item> v{std::make_pair(1, val), std::make_pair(len_b, entry.second)};
-            values.insert(values.begin() + idx_pair + 1, begin(v), end(v));
+            // value inside of run needs to be replaced
+            // split run, insert inbetween
+            uint8_t len_a = idx_in_run, len_b = length - len_a - 1;
+            RunValue run_value = run_values[idx_run];
+
+            run_lengths[idx_run] = len_a;
+            std::vector<uint8_t> lengths{1, len_b};
+            std::vector<RunValue> values{val, run_value};
+            run_lengths.insert(run_lengths.begin() + idx_run + 1, begin(lengths), end(lengths));
+            run_values.insert(run_values.begin() + idx_run + 1, begin(values), end(values));
         }
     }
 
@@ -232,17 +469,18 @@ namespace CoGaDB
     template <class T>
     void RLECompressedColumn<T>::remove(TID tid)
     {
-        size_t idx_pair = 0, idx_str = 0;
-        tid_to_idx(tid, idx_pair, idx_str);
+        size_t idx_run = 0, idx_in_run = 0;
+        tid_to_idx(tid, idx_run, idx_in_run);
+        cursor.reset();
 
-        auto &entry = values[idx_pair];
-        if (entry.first == 1)
+        if (run_lengths[idx_run] == 1)
         {
-            values.erase(values.begin() + idx_pair);
+            run_lengths.erase(run_lengths.begin() + idx_run);
+            run_values.erase(run_values.begin() + idx_run);
         }
         else
         {
-            values[idx_pair].first--;
+            run_lengths[idx_run]--;
         }
     }
 
@@ -258,7 +496,9 @@ namespace CoGaDB
     template <class T>
     void RLECompressedColumn<T>::clearContent()
     {
-        values.clear();
+        run_lengths.clear();
+        run_values.clear();
+        cursor.reset();
     }
 
     template <class T>
@@ -288,20 +528,438 @@ namespace CoGaDB
     T RLECompressedColumn<T>::operator[](int idx)
     {
         static T t;
-        for (auto &pair : values)
+        for (size_t run = 0; run < run_values.size(); ++run)
         {
-            if (pair.first > idx)
-                return pair.second;
+            if (run_lengths[run] > idx)
+                return run_values[run];
             else
-                idx -= pair.first;
+                idx -= run_lengths[run];
         }
         return t;
     }
 
+    template <class T>
+    void RLECompressedColumn<T>::decode(const TID begin, const size_t count, T *out)
+    {
+        size_t run = 0, run_start = 0;
+        findRun(begin, run, run_start);
+
+        const size_t end = begin + count;
+        for (size_t tid = begin; tid < end; ++run)
+        {
+            size_t run_end = run_start + run_lengths[run];
+            out = std::fill_n(out, std::min(run_end, end) - tid, run_values[run]);
+            tid = std::min(run_end, end);
+            run_start = run_end;
+        }
+        cursor.store(run, run_start);
+    }
+
+    template <class T>
+    void RLECompressedColumn<T>::findRun(const TID tid, size_t &run, size_t &run_start) const
+    {
+        cursor.load(run, run_start);
+        if (run > run_lengths.size() || tid < run_start / 2)
+        {
+            // no usable cursor or tid is closer to the first run
+            run = 0;
+            run_start = 0;
+        }
+
+        while (run > 0 && run_start > tid)
+            run_start -= run_lengths[--run];
+        while (run < run_lengths.size() && run_start + run_lengths[run] <= tid)
+            run_start += run_lengths[run++];
+    }
+
+    template <class T>
+    void RLECompressedColumn<T>::scanRuns(const ColumnType &value_for_comparison, const ValueComparator comp,
+                                          unsigned int number_of_threads, RunScan &scan)
+    {
+        RunValue value = std::get<T>(value_for_comparison);
+
+        size_t number_of_runs = run_values.size();
+        scan.run_starts.resize(number_of_runs);
+        size_t number_of_rows = simd::prefix_sum_run_lengths(run_lengths.data(), number_of_runs, scan.run_starts.data());
+
+        // chunk boundaries at multiples of number_of_rows / number_of_chunks
+        size_t number_of_chunks = std::max<size_t>(1, std::min<size_t>(number_of_threads, number_of_runs));
+        scan.chunks.assign(number_of_chunks + 1, number_of_runs);
+        scan.chunks[0] = 0;
+        for (size_t chunk = 1; chunk < number_of_chunks; ++chunk)
+        {
+            TID first_row = static_cast<TID>(number_of_rows * chunk / number_of_chunks);
+            scan.chunks[chunk] = std::lower_bound(scan.run_starts.begin(), scan.run_starts.end(), first_row) - scan.run_starts.begin();
+        }
+
+        scan.matches.resize(number_of_runs);
+        scan.offsets.assign(number_of_chunks + 1, 0);
+        parallel_for(number_of_chunks, [&](size_t chunk)
+        {
+            size_t begin = scan.chunks[chunk], end = scan.chunks[chunk + 1];
+            simd::evaluate_predicate(run_values.data() + begin, end - begin, value, comp, scan.matches.data() + begin);
+
+            size_t qualifying_rows = 0;
+            for (size_t run = begin; run < end; ++run)
+                qualifying_rows += scan.matches[run] * run_lengths[run];
+            scan.offsets[chunk + 1] = qualifying_rows;
+        });
+        std::partial_sum(scan.offsets.begin(), scan.offsets.end(), scan.offsets.begin());
+    }
+
+    template <class T>
+    PositionList RLECompressedColumn<T>::selection(const ColumnType &value_for_comparison, const ValueComparator comp)
+    {
+        return parallel_selection(value_for_comparison, comp, 1);
+    }
+
+    template <class T>
+    PositionList RLECompressedColumn<T>::parallel_selection(const ColumnType &value_for_comparison, const ValueComparator comp,
+                                                            unsigned int number_of_threads)
+    {
+        RunScan scan;
+        scanRuns(value_for_comparison, comp, number_of_threads, scan);
+
+        PositionList result_tids(scan.offsets.back());
+        parallel_for(scan.chunks.size() - 1, [&](size_t chunk)
+        {
+            TID *out = result_tids.data() + scan.offsets[chunk];
+            for (size_t run = scan.chunks[chunk]; run < scan.chunks[chunk + 1]; ++run)
+            {
+                if (!scan.matches[run])
+                    continue;
+                for (TID i = 0; i < run_lengths[run]; ++i)
+                    *out++ = scan.run_starts[run] + i;
+            }
+        });
+
+        return result_tids;
+    }
+
+    template <class T>
+    size_t RLECompressedColumn<T>::count(const ColumnType &value_for_comparison, const ValueComparator comp,
+                                         unsigned int number_of_threads)
+    {
+        RunScan scan;
+        scanRuns(value_for_comparison, comp, number_of_threads, scan);
+        return scan.offsets.back();
+    }
+
+    template <class T>
+    PositionList RLECompressedColumn<T>::sort(SortOrder order, unsigned int)
+    {
+        PositionList ids;
+        ids.reserve(size());
+
+        for (auto &range : sortRuns(order))
+        {
+            if (order == ASCENDING)
+            {
+                for (size_t i = 0; i < range.second; ++i)
+                    ids.push_back(range.first + i);
+            }
+            else
+            {
+                for (size_t i = range.second; i > 0; --i)
+                    ids.push_back(range.first + i - 1);
+            }
+        }
+
+        return ids;
+    }
+
+    template <class T>
+    PositionList RLECompressedColumn<T>::topK(size_t k, SortOrder order, unsigned int)
+    {
+        PositionList ids;
+
+        if (order != ASCENDING && order != DESCENDING)
+        {
+            std::cout << "FATAL ERROR: RLECompressedColumn<T>::topK(): Unknown Sorting Order!" << std::endl;
+            return ids;
+        }
+
+        std::vector<TID> run_starts(run_lengths.size());
+        simd::prefix_sum_run_lengths(run_lengths.data(), run_lengths.size(), run_starts.data());
+        std::vector<size_t> runs = nonEmptyRuns();
+
+        // the order of sortRuns: runs with equal values by ascending index for ASCENDING and by descending index for
+        // DESCENDING
+        auto precedes = [this, order](size_t a, size_t b)
+        {
+            if (order == ASCENDING)
+                return run_values[a] < run_values[b] || (!(run_values[b] < run_values[a]) && a < b);
+            return run_values[b] < run_values[a] || (!(run_values[a] < run_values[b]) && a > b);
+        };
+
+        // every run holds at least one row, so the first k rows are in the first k runs
+        const size_t number_of_runs = std::min(k, runs.size());
+        std::partial_sort(runs.begin(), runs.begin() + number_of_runs, runs.end(), precedes);
+
+        ids.reserve(std::min(k, size()));
+        for (size_t i = 0; i < number_of_runs && ids.size() < k; ++i)
+        {
+            TID first = run_starts[runs[i]];
+            size_t length = run_lengths[runs[i]];
+            size_t n = std::min(length, k - ids.size());
+            for (size_t j = 0; j < n; ++j)
+                ids.push_back(static_cast<TID>(order == ASCENDING ? first + j : first + length - 1 - j));
+        }
+
+        return ids;
+    }
+
+    template <class T>
+    std::vector<size_t> RLECompressedColumn<T>::nonEmptyRuns() const
+    {
+        std::vector<size_t> runs;
+        runs.reserve(run_values.size());
+        for (size_t i = 0; i < run_values.size(); ++i)
+        {
+            if (run_lengths[i] > 0)
+                runs.push_back(i);
+        }
+        return runs;
+    }
+
+    template <class T>
+    std::vector<typename RLECompressedColumn<T>::TIDRange> RLECompressedColumn<T>::sortRuns(SortOrder order)
+    {
+        std::vector<TIDRange> ranges;
+
+        if (order != ASCENDING && order != DESCENDING)
+        {
+            std::cout << "FATAL ERROR: RLECompressedColumn<T>::sortRuns(): Unknown Sorting Order!" << std::endl;
+            return ranges;
+        }
+
+        // index of every non-empty run together with the TID of its first row
+        std::vector<TID> run_starts(run_lengths.size());
+        simd::prefix_sum_run_lengths(run_lengths.data(), run_lengths.size(), run_starts.data());
+
+        std::vector<size_t> runs = nonEmptyRuns();
+
+        // the generic sort orders (value, TID) pairs, so equal values keep ascending TIDs for ASCENDING and
+        // descending TIDs for DESCENDING, which a stable sort of the runs in the matching position order reproduces
+        if (order == ASCENDING)
+        {
+            std::stable_sort(runs.begin(), runs.end(), [this](size_t a, size_t b)
+                             { return run_values[a] < run_values[b]; });
+        }
+        else
+        {
+            std::reverse(runs.begin(), runs.end());
+            std::stable_sort(runs.begin(), runs.end(), [this](size_t a, size_t b)
+                             { return run_values[b] < run_values[a]; });
+        }
+
+        // runs that follow each other in the column and in the sorted order are merged into a single range
+        for (size_t run : runs)
+        {
+            TID first = run_starts[run];
+            size_t length = run_lengths[run];
+            if (!ranges.empty())
+            {
+                TIDRange &last = ranges.back();
+                if (order == ASCENDING && last.first + last.second == first)
+                {
+                    last.second += length;
+                    continue;
+                }
+                if (order == DESCENDING && first + length == last.first)
+                {
+                    last.first = first;
+                    last.second += length;
+                    continue;
+                }
+            }
+            ranges.emplace_back(first, length);
+        }
+
+        return ranges;
+    }
+
+    template <class T>
+    template <class Operation>
+    bool RLECompressedColumn<T>::mapRuns(const ColumnType &new_value, Operation op)
+    {
+        if (std::holds_alternative<std::monostate>(new_value))
+            return false;
+
+        const T &value = std::get<T>(new_value);
+        for (auto &run_value : run_values)
+            run_value = op(run_value, value);
+        return true;
+    }
+
+    template <class T>
+    template <class Operation>
+    bool RLECompressedColumn<T>::zipRuns(ColumnBase &column, Operation op)
+    {
+        auto &typed_column = dynamic_cast<ColumnBaseTyped<T> &>(column);
+        if (typed_column.size() != size())
+            return false;
+
+        std::vector<uint8_t> result_lengths;
+        std::vector<RunValue> result_values;
+        result_lengths.reserve(run_lengths.size());
+        result_values.reserve(run_values.size());
+
+        if (auto *rle_column = dynamic_cast<RLECompressedColumn<T> *>(&column))
+        {
+            // merge-style walk, every output run ends where a run of either input ends
+            const std::vector<uint8_t> &other_lengths = rle_column->run_lengths;
+            const std::vector<RunValue> &other_values = rle_column->run_values;
+            size_t i = 0, j = 0, left_in_run = 0, right_in_run = 0;
+            while (i < run_values.size() && j < other_values.size())
+            {
+                if (left_in_run == 0)
+                    left_in_run = run_lengths[i];
+                if (right_in_run == 0)
+                    right_in_run = other_lengths[j];
+
+                size_t length = std::min(left_in_run, right_in_run);
+                if (length > 0)
+                    appendRun(result_lengths, result_values, length, op(run_values[i], other_values[j]));
+
+                left_in_run -= length;
+                right_in_run -= length;
+                if (left_in_run == 0)
+                    ++i;
+                if (right_in_run == 0)
+                    ++j;
+            }
+        }
+        else
+        {
+            // the other column is decoded in vectors, which are walked against the runs
+            const size_t number_of_rows = typed_column.size();
+            const size_t vector_size = std::min(ColumnBaseTyped<T>::VECTOR_SIZE, number_of_rows);
+            auto other_values = std::make_unique<T[]>(vector_size);
+            size_t run = 0, left_in_run = 0;
+            for (size_t first = 0; first < number_of_rows; first += vector_size)
+            {
+                size_t n = std::min(vector_size, number_of_rows - first);
+                typed_column.decode(static_cast<TID>(first), n, other_values.get());
+                for (size_t i = 0; i < n; ++i)
+                {
+                    while (left_in_run == 0)
+                        left_in_run = run_lengths[run++];
+                    --left_in_run;
+                    appendRun(result_lengths, result_values, 1, op(run_values[run - 1], other_values[i]));
+                }
+            }
+        }
+
+        run_lengths = std::move(result_lengths);
+        run_values = std::move(result_values);
+        cursor.reset();
+        return true;
+    }
+
+    template <class T>
+    void RLECompressedColumn<T>::appendRun(std::vector<uint8_t> &lengths, std::vector<RunValue> &values, size_t length, const T &value)
+    {
+        // fill up the last run first, exactly like inserting the rows one by one would
+        if (!values.empty() && values.back() == value)
+        {
+            size_t part = std::min(length, MAX_RUN_LENGTH - lengths.back());
+            lengths.back() += part;
+            length -= part;
+        }
+
+        for (; length > 0;)
+        {
+            size_t part = std::min(length, MAX_RUN_LENGTH);
+            lengths.push_back(static_cast<uint8_t>(part));
+            values.push_back(value);
+            length -= part;
+        }
+    }
+
+    template <class T>
+    bool RLECompressedColumn<T>::add(const ColumnType &new_value)
+    {
+        if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, bool>)
+            return ColumnBaseTyped<T>::add(new_value);
+        else
+            return mapRuns(new_value, std::plus<T>());
+    }
+
+    template <class T>
+    bool RLECompressedColumn<T>::add(ColumnBase &column)
+    {
+        if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, bool>)
+            return ColumnBaseTyped<T>::add(column);
+        else
+            return zipRuns(column, std::plus<T>());
+    }
+
+    template <class T>
+    bool RLECompressedColumn<T>::minus(const ColumnType &new_value)
+    {
+        if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, bool>)
+            return ColumnBaseTyped<T>::minus(new_value);
+        else
+            return mapRuns(new_value, std::minus<T>());
+    }
+
+    template <class T>
+    bool RLECompressedColumn<T>::minus(ColumnBase &column)
+    {
+        if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, bool>)
+            return ColumnBaseTyped<T>::minus(column);
+        else
+            return zipRuns(column, std::minus<T>());
+    }
+
+    template <class T>
+    bool RLECompressedColumn<T>::multiply(const ColumnType &new_value)
+    {
+        if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, bool>)
+            return ColumnBaseTyped<T>::multiply(new_value);
+        else
+            return mapRuns(new_value, std::multiplies<T>());
+    }
+
+    template <class T>
+    bool RLECompressedColumn<T>::multiply(ColumnBase &column)
+    {
+        if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, bool>)
+            return ColumnBaseTyped<T>::multiply(column);
+        else
+            return zipRuns(column, std::multiplies<T>());
+    }
+
+    template <class T>
+    bool RLECompressedColumn<T>::division(const ColumnType &new_value)
+    {
+        if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, bool>)
+        {
+            return ColumnBaseTyped<T>::division(new_value);
+        }
+        else
+        {
+            // check that we do not divide by zero
+            if (std::holds_alternative<T>(new_value) && std::get<T>(new_value) == 0)
+                return false;
+            return mapRuns(new_value, std::divides<T>());
+        }
+    }
+
+    template <class T>
+    bool RLECompressedColumn<T>::division(ColumnBase &column)
+    {
+        if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, bool>)
+            return ColumnBaseTyped<T>::division(column);
+        else
+            return zipRuns(column, std::divides<T>());
+    }
+
     template <class T>
     size_t RLECompressedColumn<T>::getSizeInBytes() const noexcept
     {
-        return values.size() * sizeof(Item);
+        return run_lengths.size() * sizeof(uint8_t) + run_values.size() * sizeof(RunValue);
     }
 
     /***************** End of Implementation Section ******************/
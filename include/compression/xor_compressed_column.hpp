@@ -0,0 +1,142 @@
+#pragma once
+
+#include "bit_stream.hpp"
+#include "block_compressed_column.hpp"
+#include <array>
+#include <cstring>
+
+namespace CoGaDB
+{
+
+    /*!
+     *  \brief     This class represents the XOR coding of blocks of a 32 bit floating point type T.
+     *  \details   The encoding follows the float compression of Facebook's Gorilla: every row is XORed with its
+     * predecessor, and for slowly changing values most bits of the result are zero. An unchanged row costs a single bit.
+     * Otherwise only the bits between the leading and the trailing zeros of the XOR are written, either reusing the
+     * window of the previous row or preceded by the new number of leading zeros and bits. Every block starts with the
+     * raw bits of its first row as checkpoint, so accessing a row decodes a single block and operator[] is
+     * O(BLOCK_SIZE).
+     */
+    template <class T>
+    struct XORCodec
+    {
+        static_assert(std::is_floating_point_v<T> && sizeof(T) == sizeof(uint32_t),
+                      "XOR coding is implemented for 32 bit floating point values");
+
+        static constexpr size_t BLOCK_SIZE = 128;
+
+        struct Block
+        {
+            uint32_t checkpoint = 0;    // bits of the first row of the block
+            std::vector<uint64_t> bits; // XOR coded rows 1 to BLOCK_SIZE - 1 in the layout of bit_stream::BitWriter
+
+            template <class Archive>
+            void serialize(Archive &archive)
+            {
+                archive(checkpoint, bits);
+            }
+        };
+
+        static Block encodeBlock(const T *values);
+
+        // decodes the first number_of_rows rows of block
+        static void decodeBlock(const Block &block, T *values, size_t number_of_rows = BLOCK_SIZE);
+
+        static T decodeRow(const Block &block, size_t i);
+
+        static size_t sizeInBytes(const Block &block);
+    };
+
+    /*!
+     *  \brief     This class represents an XOR compressed column with a 32 bit floating point type T.
+     */
+    template <class T>
+    using XORCompressedColumn = BlockCompressedColumn<T, XORCodec<T>>;
+
+    /***************** Start of Implementation Section ******************/
+
+    template <class T>
+    typename XORCodec<T>::Block XORCodec<T>::encodeBlock(const T *values)
+    {
+        std::array<uint32_t, BLOCK_SIZE> rows;
+        std::memcpy(rows.data(), values, sizeof(rows));
+
+        Block block;
+        block.checkpoint = rows[0];
+
+        bit_stream::BitWriter writer(block.bits);
+        unsigned leading_zeros = 32, trailing_zeros = 0; // window of the last written XOR, none yet
+        for (size_t i = 1; i < BLOCK_SIZE; ++i)
+        {
+            uint32_t xored = rows[i] ^ rows[i - 1];
+            if (xored == 0)
+            {
+                writer.write(0, 1);
+                continue;
+            }
+            writer.write(1, 1);
+
+            unsigned new_leading_zeros = bit_stream::count_leading_zeros(xored);
+            unsigned new_trailing_zeros = bit_stream::count_trailing_zeros(xored);
+            if (new_leading_zeros >= leading_zeros && new_trailing_zeros >= trailing_zeros)
+            {
+                writer.write(0, 1);
+                writer.write(xored >> trailing_zeros, 32 - leading_zeros - trailing_zeros);
+            }
+            else
+            {
+                leading_zeros = new_leading_zeros;
+                trailing_zeros = new_trailing_zeros;
+                unsigned meaningful_bits = 32 - leading_zeros - trailing_zeros;
+                writer.write(1, 1);
+                writer.write(leading_zeros, 5);
+                writer.write(meaningful_bits - 1, 5);
+                writer.write(xored >> trailing_zeros, meaningful_bits);
+            }
+        }
+        return block;
+    }
+
+    template <class T>
+    void XORCodec<T>::decodeBlock(const Block &block, T *values, size_t number_of_rows)
+    {
+        std::array<uint32_t, BLOCK_SIZE> rows;
+        rows[0] = block.checkpoint;
+
+        bit_stream::BitReader reader(block.bits);
+        unsigned leading_zeros = 32, trailing_zeros = 0;
+        for (size_t i = 1; i < number_of_rows; ++i)
+        {
+            uint32_t xored = 0;
+            if (reader.read(1))
+            {
+                if (reader.read(1))
+                {
+                    leading_zeros = reader.read(5);
+                    trailing_zeros = 32 - leading_zeros - (reader.read(5) + 1);
+                }
+                xored = reader.read(32 - leading_zeros - trailing_zeros) << trailing_zeros;
+            }
+            rows[i] = rows[i - 1] ^ xored;
+        }
+        std::memcpy(values, rows.data(), number_of_rows * sizeof(T));
+    }
+
+    template <class T>
+    T XORCodec<T>::decodeRow(const Block &block, size_t i)
+    {
+        // only the rows up to i have to be decoded
+        std::array<T, BLOCK_SIZE> rows;
+        decodeBlock(block, rows.data(), i + 1);
+        return rows[i];
+    }
+
+    template <class T>
+    size_t XORCodec<T>::sizeInBytes(const Block &block)
+    {
+        return sizeof(block.checkpoint) + block.bits.size() * sizeof(uint64_t);
+    }
+
+    /***************** End of Implementation Section ******************/
+
+} // namespace CoGaDB
@@ -66,8 +66,9 @@ namespace CoGaDB {
         [[nodiscard]] virtual std::unique_ptr<ColumnBase> copy() const = 0;
         /************ relational operations on Columns which return a PositionListPtr/PositionListPairPtr *************/
         /*! \brief sorts a column w.r.t. a SortOrder
+         * \details the additional parameter specifies the number of threads that may be used to perform the operation
          * \return PositionListPtr to a PositionList, which represents the result*/
-        virtual PositionList sort(SortOrder order = ASCENDING) = 0;
+        virtual PositionList sort(SortOrder order = ASCENDING, unsigned int number_of_threads = 1) = 0;
 
         /*! \brief filters the values of a column according to a filter condition consisting of a comparison value and a
          * ValueComparator (=,<,>) \return PositionListPtr to a PositionList, which represents the result*/
@@ -80,13 +81,30 @@ namespace CoGaDB {
                                                 ValueComparator comp,
                                                 unsigned int number_of_threads) = 0;
 
+        /*! \brief counts the values of a column that fulfill a filter condition consisting of a comparison value and a
+         * ValueComparator (=,<,>) \details this is the COUNT aggregate of a selection, the additional parameter
+         * specifies the number of threads that may be used to perform the operation \return number of qualifying rows*/
+        virtual size_t count(const ColumnType &value_for_comparison,
+                             ValueComparator comp,
+                             unsigned int number_of_threads = 1) = 0;
+
         /*! \brief joins two columns using the hash join algorithm
          * \return PositionListPairPtr to a PositionListPair, which represents the result*/
         virtual PositionListPair hash_join(ColumnBase &join_column) = 0;
 
+        /*! \brief joins two columns using the radix partitioned hash join algorithm
+         * \details the additional parameter specifies the number of threads that may be used to partition the inputs
+         * and to join the pairs of partitions, if ordered is false, the pairs are returned in partition order instead of
+         * the order of hash_join
+         * \return PositionListPairPtr to a PositionListPair, which represents the result*/
+        virtual PositionListPair parallel_hash_join(ColumnBase &join_column,
+                                                    unsigned int number_of_threads,
+                                                    bool ordered = true) = 0;
+
         /*! \brief joins two columns using the sort merge join algorithm
+         * \details the additional parameter specifies the number of threads that may be used to sort and merge the inputs
          * \return PositionListPairPtr to a PositionListPair, which represents the result*/
-        virtual PositionListPair sort_merge_join(ColumnBase &join_column) = 0;
+        virtual PositionListPair sort_merge_join(ColumnBase &join_column, unsigned int number_of_threads = 1) = 0;
 
         /*! \brief joins two columns using the nested loop join algorithm
          * \return PositionListPairPtr to a PositionListPair, which represents the result*/
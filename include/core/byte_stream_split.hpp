@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+/*! \brief Byte-stream-split layout for fixed size values.
+ *  \details Byte b of every value goes to stream b, so a float becomes one stream of sign/exponent bytes and three
+ * streams of mantissa bytes. For values of similar magnitude the high order streams consist of long runs of the same
+ * byte. Every stream is run-length encoded if that makes it smaller and kept as it is otherwise. Byte b is taken from
+ * the bit representation of the value, (bits >> 8 * b) & 0xFF, so the streams do not depend on the byte order of the
+ * machine.*/
+namespace CoGaDB::byte_stream_split {
+
+    struct Stream {
+        std::vector<uint8_t> run_lengths; // length of every run, empty if the stream is not run-length encoded
+        std::vector<uint8_t> bytes;       // the run values, or the raw bytes of the stream
+
+        template<class Archive>
+        void serialize(Archive &archive) {
+            archive(run_lengths, bytes);
+        }
+    };
+
+    /*! \brief unsigned integer with the size of T */
+    template<class T>
+    using Bits = std::conditional_t<sizeof(T) == sizeof(uint32_t), uint32_t, uint64_t>;
+
+    /*! \brief splits n values into sizeof(T) encoded streams */
+    template<class T>
+    std::vector<Stream> encode(const T *values, size_t n) {
+        static_assert(sizeof(T) == sizeof(uint32_t) || sizeof(T) == sizeof(uint64_t),
+                      "byte stream split is implemented for 4 and 8 byte values");
+        std::vector<Bits<T>> bits(n);
+        if (n > 0)
+            std::memcpy(bits.data(), values, n * sizeof(T));
+
+        std::vector<Stream> streams(sizeof(T));
+        std::vector<uint8_t> raw(n);
+        for (size_t byte = 0; byte < sizeof(T); ++byte) {
+            for (size_t i = 0; i < n; ++i)
+                raw[i] = static_cast<uint8_t>(bits[i] >> (8 * byte));
+
+            Stream &stream = streams[byte];
+            for (size_t i = 0; i < n; ++i) {
+                if (stream.bytes.empty() || stream.bytes.back() != raw[i] || stream.run_lengths.back() == UINT8_MAX) {
+                    stream.bytes.push_back(raw[i]);
+                    stream.run_lengths.push_back(0);
+                }
+                stream.run_lengths.back()++;
+            }
+
+            // a run costs two bytes, streams without long runs are cheaper as they are
+            if (2 * stream.run_lengths.size() >= n) {
+                stream.run_lengths.clear();
+                stream.bytes = raw;
+            }
+        }
+        return streams;
+    }
+
+    /*! \brief reassembles n values from the streams encode() returned */
+    template<class T>
+    void decode(const std::vector<Stream> &streams, size_t n, T *values) {
+        std::vector<Bits<T>> bits(n, 0);
+        for (size_t byte = 0; byte < sizeof(T); ++byte) {
+            const Stream &stream = streams[byte];
+            const unsigned shift = 8 * byte;
+            if (stream.run_lengths.empty()) {
+                for (size_t i = 0; i < n; ++i)
+                    bits[i] |= Bits<T>(stream.bytes[i]) << shift;
+                continue;
+            }
+
+            size_t i = 0;
+            for (size_t run = 0; run < stream.run_lengths.size(); ++run) {
+                const Bits<T> value = Bits<T>(stream.bytes[run]) << shift;
+                for (uint8_t j = 0; j < stream.run_lengths[run]; ++j, ++i)
+                    bits[i] |= value;
+            }
+        }
+        if (n > 0)
+            std::memcpy(values, bits.data(), n * sizeof(T));
+    }
+
+    /*! \brief number of bytes the encoded streams occupy */
+    inline size_t size_in_bytes(const std::vector<Stream> &streams) {
+        size_t size = 0;
+        for (auto const &stream: streams)
+            size += stream.run_lengths.size() + stream.bytes.size();
+        return size;
+    }
+
+} // namespace CoGaDB::byte_stream_split
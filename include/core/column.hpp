@@ -3,7 +3,9 @@
 #include <cereal/archives/portable_binary.hpp>
 #include <cereal/types/string.hpp>
 #include <cereal/types/vector.hpp>
+#include <core/byte_stream_split.hpp>
 #include <core/column_base_typed.hpp>
+#include <core/simd_kernels.hpp>
 #include <fstream>
 #include <iostream>
 #include <numeric>
@@ -57,16 +59,60 @@ namespace CoGaDB {
         template<class Archive>
         /**
          * @brief Serialization method called by Cereal. Implement this method in your compressed columns to get serialization working.
+         * @details float columns are stored in the byte-stream-split layout, starting with a marker and a version
+         * number. Files that hold the plain vector of floats start with its length instead and are still loaded.
          */
         void serialize(Archive &archive) {
-            archive(values_); // serialize things by passing them to the archive
+            if constexpr (std::is_same_v<T, float>) {
+                serializeByteStreamSplit(archive);
+            } else {
+                archive(values_); // serialize things by passing them to the archive
+            }
         }
 
         T operator[](int index) final;
 
+        /*! \brief int and float columns are scanned with the SIMD kernel of simd::select_positions, which writes the
+         * TIDs directly into the result, one vector of VECTOR_SIZE rows at a time */
+        PositionList selection(const ColumnType &value_for_comparison, ValueComparator comp) final;
+
+        /*! \brief copies the values of the rows [begin, begin + count) */
+        void decode(TID begin, size_t count, T *out) final;
+
         [[maybe_unused]] std::vector<T> &getContent();
 
     private:
+        static constexpr uint64_t FORMAT_MARKER = UINT64_MAX;
+        static constexpr uint32_t FORMAT_VERSION = 1;
+
+        template<class Archive>
+        void serializeByteStreamSplit(Archive &archive) {
+            if constexpr (Archive::is_loading::value) {
+                uint64_t header = 0;
+                archive(header);
+                if (header == FORMAT_MARKER) {
+                    uint32_t version = 0;
+                    uint64_t number_of_values = 0;
+                    std::vector<byte_stream_split::Stream> streams;
+                    archive(version);
+                    if (version != FORMAT_VERSION)
+                        throw cereal::Exception("unsupported column format version " + std::to_string(version));
+                    archive(number_of_values, streams);
+                    values_.resize(number_of_values);
+                    byte_stream_split::decode(streams, values_.size(), values_.data());
+                } else {
+                    // legacy format, header is the number of values
+                    values_.resize(header);
+                    for (auto &value: values_)
+                        archive(value);
+                }
+            } else {
+                uint64_t number_of_values = values_.size();
+                archive(FORMAT_MARKER, FORMAT_VERSION, number_of_values,
+                        byte_stream_split::encode(values_.data(), values_.size()));
+            }
+        }
+
         struct Type_TID_Comparator {
             inline bool operator()(std::pair<T, TID> i, std::pair<T, TID> j) {
                 return (i.first < j.first);
@@ -177,6 +223,32 @@ namespace CoGaDB {
         return values_[index];
     }
 
+    template<class T>
+    PositionList Column<T>::selection(const ColumnType &value_for_comparison, const ValueComparator comp) {
+        if constexpr (std::is_same_v<T, int> || std::is_same_v<T, float>) {
+            T value = std::get<T>(value_for_comparison);
+            if (!quiet)
+                std::cout << "Using CPU for Selection..." << std::endl;
+
+            // the list grows by one vector at a time, so the kernel writes to entries that are still in the cache
+            PositionList result_tids;
+            for (size_t first = 0; first < values_.size(); first += this->VECTOR_SIZE) {
+                size_t n = std::min(this->VECTOR_SIZE, values_.size() - first), start = result_tids.size();
+                result_tids.resize(start + n);
+                result_tids.resize(start + simd::select_positions(values_.data() + first, n, value, comp,
+                                                                  static_cast<TID>(first), result_tids.data() + start));
+            }
+            return result_tids;
+        } else {
+            return ColumnBaseTyped<T>::selection(value_for_comparison, comp);
+        }
+    }
+
+    template<class T>
+    void Column<T>::decode(const TID begin, const size_t count, T *out) {
+        std::copy(values_.begin() + begin, values_.begin() + begin + count, out);
+    }
+
     template<class T>
     size_t Column<T>::getSizeInBytes() const noexcept {
         return values_.capacity() * sizeof(T);
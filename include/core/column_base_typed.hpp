@@ -3,14 +3,21 @@
 
 #include <algorithm>
 #include <any>
+#include <atomic>
 #include <cassert>
 #include <core/base_column.hpp>
+#include <core/hash_table.hpp>
+#include <core/parallel.hpp>
+#include <core/radix_partitioning.hpp>
+#include <core/radix_sort.hpp>
+#include <core/simd_kernels.hpp>
 #include <fstream>
 #include <functional>
 #include <iostream>
+#include <iterator>
 #include <memory>
+#include <numeric>
 #include <string>
-#include <unordered_map>
 #include <utility>
 
 
@@ -45,7 +52,15 @@ namespace CoGaDB {
         virtual void insert(const T &new_Value) = 0;
 
         /***************** relational operations on Columns which return lookup tables *****************/
-        PositionList sort(SortOrder order) override;
+        /*! \brief sorts int and float columns with radix_sort and all other types with parallel_sort
+         * \details Equal values are ordered by ascending TID for ASCENDING and by descending TID for DESCENDING.*/
+        PositionList sort(SortOrder order, unsigned int number_of_threads = 1) override;
+
+        /*! \brief the first k TIDs of sort(order) without sorting the whole column
+         * \details Every thread keeps the k rows of its part of the column that come first in a bounded heap, the
+         * heaps are merged at the end. Compressed columns override this to take the rows from their sorted dictionary
+         * or runs.*/
+        virtual PositionList topK(size_t k, SortOrder order = ASCENDING, unsigned int number_of_threads = 1);
 
         PositionList selection(const ColumnType &value_for_comparison, ValueComparator comp) override;
 
@@ -53,10 +68,28 @@ namespace CoGaDB {
                                         ValueComparator comp,
                                         unsigned int number_of_threads) override;
 
+        size_t count(const ColumnType &value_for_comparison,
+                     ValueComparator comp,
+                     unsigned int number_of_threads = 1) override;
+
         // join algorithms
+        /*! \brief builds a FlatHashTable on the smaller column and probes it with the larger one
+         * \details The result is ordered by the TIDs of the probed column.*/
         PositionListPair hash_join(ColumnBase &join_column) override;
 
-        PositionListPair sort_merge_join(ColumnBase &join_column) override;
+        /*! \brief partitions both columns by hash bits until the partitions of the smaller column fit into the cache,
+         * then builds and probes a FlatHashTable for every pair of partitions in parallel
+         * \details If ordered is true, the result is ordered like the result of hash_join. Otherwise the pairs of
+         * every partition follow each other, which saves a pass over the result.*/
+        PositionListPair parallel_hash_join(ColumnBase &join_column,
+                                            unsigned int number_of_threads,
+                                            bool ordered = true) override;
+
+        /*! \brief sorts both columns into (value, TID) pairs in parallel, or takes them as they are if the values are
+         * already in ascending order, and merges value ranges of the sorted pairs in parallel
+         * \details The result is ordered by the join value, equal values by the TID of this column and then by the TID
+         * of join_column.*/
+        PositionListPair sort_merge_join(ColumnBase &join_column, unsigned int number_of_threads = 1) override;
 
         PositionListPair nested_loop_join(ColumnBase &join_column) override;
 
@@ -83,39 +116,239 @@ namespace CoGaDB {
          * */
         virtual T operator[](int index) = 0;
 
+        /*! \brief writes the values of the rows [begin, begin + count) to out
+         * \details The generic operators decode the column in vectors of VECTOR_SIZE rows with this method instead of
+         * calling operator[] for every row. The default implementation still calls operator[], derived classes
+         * override it to decode whole blocks, runs or segments at once.
+         * */
+        virtual void decode(TID begin, size_t count, T *out);
+
         inline bool operator==(const ColumnBaseTyped<T> &column) const;
 
 
         /*! \brief returns database type of column (as defined in "SQL" statement)*/
         [[nodiscard]] AttributeType getType() const final;
+
+    protected:
+        /*! \brief number of rows the generic operators decode at once */
+        static constexpr size_t VECTOR_SIZE = 2048;
+
+    private:
+        // number of consecutive rows a worker thread claims at once in parallel_selection and count
+        static constexpr size_t MORSEL_SIZE = 16384;
+
+        // calls function(values, first, n) for the rows [begin, end) in vectors of at most VECTOR_SIZE rows, values
+        // holds the n decoded rows starting at row first
+        template<class Function>
+        void forEachVector(size_t begin, size_t end, Function function);
+
+        // appends the TIDs of the rows [first, first + n) with predicate(values[i], value) to result_tids
+        template<class Predicate>
+        static void select(const T *values, TID first, size_t n, const T &value, Predicate predicate,
+                           PositionList &result_tids);
+
+        // row = operation(row, value) for all rows
+        template<class Operation>
+        bool apply(const ColumnType &new_value, Operation operation);
+
+        // row = operation(row, row of column) for all rows, false if the columns differ in size
+        template<class Operation>
+        bool apply(ColumnBase &column, Operation operation);
+
+        // calls function(morsel, begin, end) for every morsel of the column, the morsels are handed out to
+        // number_of_threads threads one at a time, so threads that finish early take over the remaining work
+        template<class Function>
+        void forEachMorsel(unsigned int number_of_threads, Function function);
+
+        // the values of all rows, the morsels are decoded by number_of_threads threads
+        std::unique_ptr<T[]> decodeAll(unsigned int number_of_threads);
+
+        // concatenates the lists in order, the lists are copied to their offsets in the result in parallel
+        static PositionList concatenate(const std::vector<PositionList> &lists, unsigned int number_of_threads);
+
+        // the (value, TID) pairs of all rows ordered by value, rows with equal values in TID order
+        std::vector<std::pair<T, TID>> sortedPairs(unsigned int number_of_threads);
     };
 
     template<class T>
-    PositionList ColumnBaseTyped<T>::sort(SortOrder order) {
-        PositionList ids;
-        std::vector<std::pair<T, TID>> v;
+    PositionList ColumnBaseTyped<T>::sort(SortOrder order, unsigned int number_of_threads) {
+        number_of_threads = std::max(number_of_threads, 1u);
+        if constexpr (std::is_same_v<T, int> || std::is_same_v<T, float>) {
+            if (order == ASCENDING || order == DESCENDING) {
+                PositionList ids = radix_sort(decodeAll(number_of_threads).get(), this->size());
+                // the comparisons below order equal values by descending TID for DESCENDING
+                if (order == DESCENDING)
+                    std::reverse(ids.begin(), ids.end());
+                return ids;
+            }
+        }
 
-        for (unsigned int i = 0; i < this->size(); i++) {
-            v.push_back(std::pair<T, TID>((*this)[i], i));
+        std::vector<std::pair<T, TID>> v(this->size());
+        {
+            auto values = decodeAll(number_of_threads);
+            forEachMorsel(number_of_threads, [&](size_t, size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i++)
+                    v[i] = {std::move(values[i]), static_cast<TID>(i)};
+            });
         }
 
+        // the TIDs make all pairs distinct, so equal values are ordered by TID
         if (order == ASCENDING) {
-            std::stable_sort(v.begin(), v.end(), std::less_equal<std::pair<T, TID>>());
+            parallel_sort(v.begin(), v.end(), std::less<std::pair<T, TID>>(), number_of_threads);
         } else if (order == DESCENDING) {
-            std::stable_sort(v.begin(), v.end(), std::greater_equal<std::pair<T, TID>>());
+            parallel_sort(v.begin(), v.end(), std::greater<std::pair<T, TID>>(), number_of_threads);
         } else {
             std::cout << "FATAL ERROR: ColumnBaseTyped<T>::sort(): Unknown Sorting Order!" << std::endl;
         }
 
-        for (auto &elem: v)
-            ids.push_back(elem.second);
+        PositionList ids(v.size());
+        for (size_t i = 0; i < v.size(); i++)
+            ids[i] = v[i].second;
 
         return ids;
     }
 
     template<class T>
-    PositionList ColumnBaseTyped<T>::parallel_selection(const ColumnType &, const ValueComparator, unsigned int) {
-        PositionList result_tids;
+    PositionList ColumnBaseTyped<T>::topK(size_t k, SortOrder order, unsigned int number_of_threads) {
+        if (order != ASCENDING && order != DESCENDING) {
+            std::cout << "FATAL ERROR: ColumnBaseTyped<T>::topK(): Unknown Sorting Order!" << std::endl;
+            return {};
+        }
+        if (k >= this->size())
+            return sort(order, number_of_threads);
+        if (k == 0)
+            return {};
+
+        // row a comes before row b in sort(order), equal values by ascending TID for ASCENDING and descending TID for
+        // DESCENDING
+        auto precedes = [order](const T &a, TID a_tid, const T &b, TID b_tid) {
+            if (order == ASCENDING)
+                return a < b || (!(b < a) && a_tid < b_tid);
+            return b < a || (!(a < b) && a_tid > b_tid);
+        };
+        auto heap_order = [&](const std::pair<T, TID> &a, const std::pair<T, TID> &b) {
+            return precedes(a.first, a.second, b.first, b.second);
+        };
+
+        // the top of every heap is the row of the heap that comes last
+        const size_t number_of_rows = this->size();
+        const size_t number_of_parts = std::max<size_t>(
+                1, std::min<size_t>(std::max(number_of_threads, 1u), number_of_rows / MORSEL_SIZE));
+        std::vector<std::vector<std::pair<T, TID>>> heaps(number_of_parts);
+        parallel_for(number_of_parts, [&](size_t part) {
+            auto &heap = heaps[part];
+            heap.reserve(k);
+            forEachVector(number_of_rows * part / number_of_parts, number_of_rows * (part + 1) / number_of_parts,
+                          [&](const T *values, TID first, size_t n) {
+                for (size_t i = 0; i < n; i++) {
+                    const auto tid = static_cast<TID>(first + i);
+                    if (heap.size() < k) {
+                        heap.emplace_back(values[i], tid);
+                        std::push_heap(heap.begin(), heap.end(), heap_order);
+                    } else if (precedes(values[i], tid, heap.front().first, heap.front().second)) {
+                        std::pop_heap(heap.begin(), heap.end(), heap_order);
+                        heap.back() = {values[i], tid};
+                        std::push_heap(heap.begin(), heap.end(), heap_order);
+                    }
+                }
+            });
+        });
+
+        std::vector<std::pair<T, TID>> candidates;
+        for (auto &heap: heaps)
+            std::move(heap.begin(), heap.end(), std::back_inserter(candidates));
+        std::partial_sort(candidates.begin(), candidates.begin() + static_cast<std::ptrdiff_t>(k), candidates.end(),
+                          heap_order);
+
+        PositionList ids(k);
+        for (size_t i = 0; i < k; i++)
+            ids[i] = candidates[i].second;
+        return ids;
+    }
+
+    template<class T>
+    void ColumnBaseTyped<T>::decode(TID begin, size_t count, T *out) {
+        for (size_t i = 0; i < count; i++)
+            out[i] = (*this)[static_cast<int>(begin + i)];
+    }
+
+    template<class T>
+    template<class Function>
+    void ColumnBaseTyped<T>::forEachVector(size_t begin, size_t end, Function function) {
+        auto values = std::make_unique<T[]>(begin < end ? std::min(VECTOR_SIZE, end - begin) : 0);
+        for (size_t first = begin; first < end; first += VECTOR_SIZE) {
+            size_t n = std::min(VECTOR_SIZE, end - first);
+            decode(static_cast<TID>(first), n, values.get());
+            function(static_cast<const T *>(values.get()), static_cast<TID>(first), n);
+        }
+    }
+
+    template<class T>
+    template<class Predicate>
+    void ColumnBaseTyped<T>::select(const T *values, TID first, size_t n, const T &value, Predicate predicate,
+                                    PositionList &result_tids) {
+        if constexpr (std::is_same_v<T, int> || std::is_same_v<T, float>) {
+            size_t start = result_tids.size();
+            result_tids.resize(start + n);
+            result_tids.resize(start + simd::select_positions(values, n, value, Predicate::comparator, first,
+                                                              result_tids.data() + start));
+        } else {
+            for (size_t i = 0; i < n; i++)
+                if (predicate(values[i], value))
+                    result_tids.push_back(static_cast<TID>(first + i));
+        }
+    }
+
+    template<class T>
+    template<class Function>
+    void ColumnBaseTyped<T>::forEachMorsel(unsigned int number_of_threads, Function function) {
+        const size_t number_of_rows = this->size();
+        const size_t number_of_morsels = (number_of_rows + MORSEL_SIZE - 1) / MORSEL_SIZE;
+
+        std::atomic<size_t> next_morsel(0);
+        parallel_for(std::min<size_t>(number_of_threads, number_of_morsels), [&](size_t) {
+            for (size_t morsel = next_morsel++; morsel < number_of_morsels; morsel = next_morsel++) {
+                size_t begin = morsel * MORSEL_SIZE;
+                function(morsel, begin, std::min(begin + MORSEL_SIZE, number_of_rows));
+            }
+        });
+    }
+
+    template<class T>
+    PositionList ColumnBaseTyped<T>::parallel_selection(const ColumnType &value_for_comparison,
+                                                        const ValueComparator comp,
+                                                        unsigned int number_of_threads) {
+        if (number_of_threads <= 1)
+            return selection(value_for_comparison, comp);
+
+        T value = std::get<T>(value_for_comparison);
+
+        // every morsel collects its TIDs in its own list, so the threads never write to shared memory
+        std::vector<PositionList> morsel_tids((this->size() + MORSEL_SIZE - 1) / MORSEL_SIZE);
+        with_predicate(comp, [&](auto predicate) {
+            forEachMorsel(number_of_threads, [&](size_t morsel, size_t begin, size_t end) {
+                forEachVector(begin, end, [&](const T *values, TID first, size_t n) {
+                    select(values, first, n, value, predicate, morsel_tids[morsel]);
+                });
+            });
+        });
+
+        // the morsels are concatenated in TID order
+        return concatenate(morsel_tids, number_of_threads);
+    }
+
+    template<class T>
+    PositionList ColumnBaseTyped<T>::concatenate(const std::vector<PositionList> &lists, unsigned int number_of_threads) {
+        std::vector<size_t> offsets(lists.size() + 1, 0);
+        for (size_t list = 0; list < lists.size(); list++)
+            offsets[list + 1] = offsets[list] + lists[list].size();
+
+        PositionList result_tids(offsets.back());
+        std::atomic<size_t> next_list(0);
+        parallel_for(std::min<size_t>(number_of_threads, lists.size()), [&](size_t) {
+            for (size_t list = next_list++; list < lists.size(); list = next_list++)
+                std::copy(lists[list].begin(), lists[list].end(), result_tids.begin() + offsets[list]);
+        });
 
         return result_tids;
     }
@@ -128,37 +361,43 @@ namespace CoGaDB {
 
         if (!quiet)
             std::cout << "Using CPU for Selection..." << std::endl;
-        for (TID i = 0; i < this->size(); i++) {
-            // std::any value = column->get(i);
-            // val = values_[i];
-
-            if (comp == EQUAL) {
-                if (value == (*this)[i]) {
-                    // result_table->insert(this->fetchTuple(i));
-                    result_tids.push_back(i);
-                }
-            } else if (comp == LESSER) {
-                if ((*this)[i] < value) {
-                    // result_table->insert(this->fetchTuple(i));
-                    result_tids.push_back(i);
-                }
-            } else if (comp == GREATER) {
-                if ((*this)[i] > value) {
-                    result_tids.push_back(i);
-                    // result_table->insert(this->fetchTuple(i));
-                }
-            } else {
-            }
-        }
+        with_predicate(comp, [&](auto predicate) {
+            forEachVector(0, this->size(), [&](const T *values, TID first, size_t n) {
+                select(values, first, n, value, predicate, result_tids);
+            });
+        });
 
-        //}
         return result_tids;
     }
 
     template<class T>
-    PositionListPair ColumnBaseTyped<T>::hash_join(ColumnBase &join_column_) {
-        typedef std::unordered_multimap<T, TID, std::hash<T>, std::equal_to<T>> HashTable;
+    size_t ColumnBaseTyped<T>::count(const ColumnType &value_for_comparison, const ValueComparator comp,
+                                     unsigned int number_of_threads) {
+        if (number_of_threads <= 1)
+            return selection(value_for_comparison, comp).size();
+
+        T value = std::get<T>(value_for_comparison);
 
+        std::vector<size_t> morsel_counts((this->size() + MORSEL_SIZE - 1) / MORSEL_SIZE, 0);
+        with_predicate(comp, [&](auto predicate) {
+            forEachMorsel(number_of_threads, [&](size_t morsel, size_t begin, size_t end) {
+                size_t qualifying_rows = 0;
+                forEachVector(begin, end, [&](const T *values, TID, size_t n) {
+                    for (size_t i = 0; i < n; i++)
+                        qualifying_rows += predicate(values[i], value);
+                });
+                morsel_counts[morsel] = qualifying_rows;
+            });
+        });
+
+        size_t qualifying_rows = 0;
+        for (size_t morsel_count: morsel_counts)
+            qualifying_rows += morsel_count;
+        return qualifying_rows;
+    }
+
+    template<class T>
+    PositionListPair ColumnBaseTyped<T>::hash_join(ColumnBase &join_column_) {
         if (join_column_.getType() != getType()) {
             std::cerr << "Fatal Error!!! Type mismatch for columns " << this->name_ << " and " << join_column_.getName()
                       << std::endl;
@@ -166,33 +405,146 @@ namespace CoGaDB {
             std::abort();
         }
 
-        auto &join_column = reinterpret_cast<ColumnBaseTyped<T> &>(join_column_);
+        auto &join_column = dynamic_cast<ColumnBaseTyped<T> &>(join_column_);
 
         PositionListPair join_tids;
 
-        // create hash table
-        HashTable hashtable;
-        for (unsigned int i = 0; i < this->size(); i++)
-            hashtable.insert(std::pair<T, TID>((*this)[i], i));
+        // create hash table on the smaller relation
+        const bool build_on_this = this->size() <= join_column.size();
+        ColumnBaseTyped<T> &build_column = build_on_this ? *this : join_column;
+        ColumnBaseTyped<T> &probe_column = build_on_this ? join_column : *this;
+        PositionList &build_tids = build_on_this ? join_tids.first : join_tids.second;
+        PositionList &probe_tids = build_on_this ? join_tids.second : join_tids.first;
+
+        auto build_keys = std::make_unique<T[]>(build_column.size());
+        build_column.decode(0, build_column.size(), build_keys.get());
+        FlatHashTable<T> hashtable(build_keys.get(), build_column.size());
+        build_keys.reset();
 
         // probe larger relation
-        for (unsigned int i = 0; i < join_column.size(); i++) {
-            std::pair<typename HashTable::iterator, typename HashTable::iterator> range =
-                    hashtable.equal_range(join_column[i]);
-            for (typename HashTable::iterator it = range.first; it != range.second; it++) {
-                if (it->first == join_column[i]) {
-                    join_tids.first.push_back(it->second);
-                    join_tids.second.push_back(i);
-                    // cout << "match! " << it->second << ", " << i << "	"  << it->first << endl;
-                }
-            }
+        probe_column.forEachVector(0, probe_column.size(), [&](const T *values, TID first, size_t n) {
+            hashtable.probe(values, n, [&](size_t i, TID build_tid) {
+                build_tids.push_back(build_tid);
+                probe_tids.push_back(static_cast<TID>(first + i));
+            });
+        });
+
+        return join_tids;
+    }
+
+    template<class T>
+    std::unique_ptr<T[]> ColumnBaseTyped<T>::decodeAll(unsigned int number_of_threads) {
+        auto values = std::make_unique<T[]>(this->size());
+        forEachMorsel(number_of_threads, [&](size_t, size_t begin, size_t end) {
+            decode(static_cast<TID>(begin), end - begin, values.get() + begin);
+        });
+        return values;
+    }
+
+    template<class T>
+    PositionListPair ColumnBaseTyped<T>::parallel_hash_join(ColumnBase &join_column_, unsigned int number_of_threads,
+                                                            const bool ordered) {
+        if (join_column_.getType() != getType()) {
+            std::cerr << "Fatal Error!!! Type mismatch for columns " << this->name_ << " and " << join_column_.getName()
+                      << std::endl;
+            std::cerr << "File: " << __FILE__ << " Line: " << __LINE__ << std::endl;
+            std::abort();
         }
 
+        auto &join_column = dynamic_cast<ColumnBaseTyped<T> &>(join_column_);
+        number_of_threads = std::max(number_of_threads, 1u);
+
+        PositionListPair join_tids;
+
+        const bool build_on_this = this->size() <= join_column.size();
+        ColumnBaseTyped<T> &build_column = build_on_this ? *this : join_column;
+        ColumnBaseTyped<T> &probe_column = build_on_this ? join_column : *this;
+        PositionList &build_tids = build_on_this ? join_tids.first : join_tids.second;
+        PositionList &probe_tids = build_on_this ? join_tids.second : join_tids.first;
+
+        // both columns are split on the same hash bits, so equal values end up in partitions with the same number
+        const unsigned bits = radix_partitioning::required_bits(build_column.size());
+        auto partition = [&](ColumnBaseTyped<T> &column) {
+            auto values = column.decodeAll(number_of_threads);
+            return radix_partitioning::partition(values.get(), column.size(), bits, number_of_threads);
+        };
+        const auto build = partition(build_column);
+        const auto probe = partition(probe_column);
+
+        const size_t number_of_partitions = build.offsets.size() - 1;
+        auto for_each_partition = [&](auto function) {
+            std::atomic<size_t> next_partition(0);
+            parallel_for(std::min<size_t>(number_of_threads, number_of_partitions), [&](size_t) {
+                for (size_t p = next_partition++; p < number_of_partitions; p = next_partition++)
+                    function(p);
+            });
+        };
+
+        std::vector<PositionList> partition_build_tids(number_of_partitions), partition_probe_tids(number_of_partitions);
+        for_each_partition([&](size_t p) {
+            const size_t build_begin = build.offsets[p], probe_begin = probe.offsets[p];
+            const size_t build_rows = build.offsets[p + 1] - build_begin, probe_rows = probe.offsets[p + 1] - probe_begin;
+            if (build_rows == 0 || probe_rows == 0)
+                return;
+
+            FlatHashTable<T> hashtable(build.keys.get() + build_begin, build_rows);
+            hashtable.probe(probe.keys.get() + probe_begin, probe_rows, [&](size_t i, TID row) {
+                partition_build_tids[p].push_back(build.tids[build_begin + row]);
+                partition_probe_tids[p].push_back(probe.tids[probe_begin + i]);
+            });
+        });
+
+        if (!ordered) {
+            build_tids = concatenate(partition_build_tids, number_of_threads);
+            probe_tids = concatenate(partition_probe_tids, number_of_threads);
+            return join_tids;
+        }
+
+        // every probed row belongs to a single partition, so the partitions count the matches of their rows and
+        // scatter them to their position in the order of the probed column without synchronization. The matches of a
+        // row are emitted in the TID order of the build partition, which is the TID order of the build column.
+        std::vector<size_t> positions(probe_column.size() + 1, 0);
+        for_each_partition([&](size_t p) {
+            for (TID probe_tid: partition_probe_tids[p])
+                positions[probe_tid + 1]++;
+        });
+        std::partial_sum(positions.begin(), positions.end(), positions.begin());
+
+        build_tids.resize(positions.back());
+        probe_tids.resize(positions.back());
+        for_each_partition([&](size_t p) {
+            for (size_t match = 0; match < partition_probe_tids[p].size(); match++) {
+                const TID probe_tid = partition_probe_tids[p][match];
+                const size_t position = positions[probe_tid]++;
+                build_tids[position] = partition_build_tids[p][match];
+                probe_tids[position] = probe_tid;
+            }
+        });
+
         return join_tids;
     }
 
+    template<class T>
+    std::vector<std::pair<T, TID>> ColumnBaseTyped<T>::sortedPairs(unsigned int number_of_threads) {
+        std::vector<std::pair<T, TID>> pairs;
+        pairs.reserve(this->size());
+        bool sorted = true;
+        forEachVector(0, this->size(), [&](const T *values, TID first, size_t n) {
+            for (size_t i = 0; i < n; i++) {
+                sorted = sorted && (pairs.empty() || !(values[i] < pairs.back().first));
+                pairs.emplace_back(values[i], static_cast<TID>(first + i));
+            }
+        });
+
+        // clustered columns are merged as they are, the stable sort keeps equal values in TID order
+        if (!sorted)
+            parallel_sort(pairs.begin(), pairs.end(), [](const auto &a, const auto &b) { return a.first < b.first; },
+                          number_of_threads);
+        return pairs;
+    }
+
     template<class Type>
-    PositionListPair ColumnBaseTyped<Type>::sort_merge_join(ColumnBase &join_column_) {
+    PositionListPair ColumnBaseTyped<Type>::sort_merge_join(ColumnBase &join_column_, unsigned int number_of_threads) {
         if (join_column_.getType() != getType()) {
             std::cout << "Fatal Error!!! Type mismatch for columns " << this->name_ << " and " << join_column_.getName()
                       << std::endl;
@@ -200,7 +552,67 @@ namespace CoGaDB {
             abort();
         }
 
+        auto &join_column = dynamic_cast<ColumnBaseTyped<Type> &>(join_column_);
+        number_of_threads = std::max(number_of_threads, 1u);
+
+        std::vector<std::pair<Type, TID>> left, right;
+        if (number_of_threads == 1) {
+            left = sortedPairs(1);
+            right = join_column.sortedPairs(1);
+        } else {
+            // both inputs are sorted at the same time, each with half of the threads
+            parallel_for(2, [&](size_t side) {
+                if (side == 0)
+                    left = sortedPairs(number_of_threads / 2);
+                else
+                    right = join_column.sortedPairs(number_of_threads - number_of_threads / 2);
+            });
+        }
+
+        // the value ranges of the partitions start at evenly spaced values of the left input, lower_bound puts all rows
+        // with the same value into the same partition on both sides
+        auto value_less = [](const auto &a, const auto &b) { return a.first < b.first; };
+        const size_t number_of_partitions = std::max<size_t>(1, std::min<size_t>(number_of_threads, left.size()));
+        std::vector<size_t> left_bounds(number_of_partitions + 1, left.size());
+        std::vector<size_t> right_bounds(number_of_partitions + 1, right.size());
+        left_bounds[0] = right_bounds[0] = 0;
+        for (size_t partition = 1; partition < number_of_partitions; partition++) {
+            const auto &splitter = left[left.size() * partition / number_of_partitions];
+            left_bounds[partition] = std::lower_bound(left.begin(), left.end(), splitter, value_less) - left.begin();
+            right_bounds[partition] = std::lower_bound(right.begin(), right.end(), splitter, value_less) - right.begin();
+        }
+
+        std::vector<PositionList> left_tids(number_of_partitions), right_tids(number_of_partitions);
+        parallel_for(number_of_partitions, [&](size_t partition) {
+            size_t i = left_bounds[partition], j = right_bounds[partition];
+            const size_t left_end = left_bounds[partition + 1], right_end = right_bounds[partition + 1];
+            while (i < left_end && j < right_end) {
+                if (left[i].first < right[j].first) {
+                    i++;
+                } else if (right[j].first < left[i].first) {
+                    j++;
+                } else {
+                    // every row of the group of equal values on the left joins every row of the group on the right
+                    size_t left_group_end = i + 1, right_group_end = j + 1;
+                    while (left_group_end < left_end && !(left[i].first < left[left_group_end].first))
+                        left_group_end++;
+                    while (right_group_end < right_end && !(right[j].first < right[right_group_end].first))
+                        right_group_end++;
+                    for (size_t l = i; l < left_group_end; l++) {
+                        for (size_t r = j; r < right_group_end; r++) {
+                            left_tids[partition].push_back(left[l].second);
+                            right_tids[partition].push_back(right[r].second);
+                        }
+                    }
+                    i = left_group_end;
+                    j = right_group_end;
+                }
+            }
+        });
+
         PositionListPair join_tids;
+        join_tids.first = concatenate(left_tids, number_of_threads);
+        join_tids.second = concatenate(right_tids, number_of_threads);
         return join_tids;
     }
 
@@ -218,16 +630,23 @@ namespace CoGaDB {
 
         PositionListPair join_tids;
 
-        for (unsigned int i = 0; i < this->size(); i++) {
-            for (unsigned int j = 0; j < join_column.size(); j++) {
-                if ((*this)[i] == join_column[j]) {
-                    if (debug)
-                        std::cout << "MATCH: (" << i << "," << j << ")" << std::endl;
-                    join_tids.first.push_back(i);
-                    join_tids.second.push_back(j);
+        // the inner column is decoded once instead of once per row of the outer column
+        const size_t inner_size = join_column.size();
+        auto inner_values = std::make_unique<Type[]>(inner_size);
+        join_column.decode(0, inner_size, inner_values.get());
+
+        forEachVector(0, this->size(), [&](const Type *values, TID first, size_t n) {
+            for (size_t i = 0; i < n; i++) {
+                for (size_t j = 0; j < inner_size; j++) {
+                    if (values[i] == inner_values[j]) {
+                        if (debug)
+                            std::cout << "MATCH: (" << first + i << "," << j << ")" << std::endl;
+                        join_tids.first.push_back(static_cast<TID>(first + i));
+                        join_tids.second.push_back(static_cast<TID>(j));
+                    }
                 }
             }
-        }
+        });
 
         return join_tids;
     }
@@ -236,114 +655,87 @@ namespace CoGaDB {
     bool ColumnBaseTyped<T>::operator==(const ColumnBaseTyped<T> &column) const {
         if (this->size() != column.size())
             return false;
-        for (unsigned int i = 0; i < this->size(); i++) {
-            if (const_cast<ColumnBaseTyped<T> &>(*this)[i] != const_cast<ColumnBaseTyped<T> &>(column)[i]) {
-                return false;
-            }
-        }
-        return true;
+
+        bool equal = true;
+        auto other_values = std::make_unique<T[]>(std::min(VECTOR_SIZE, column.size()));
+        const_cast<ColumnBaseTyped<T> &>(*this).forEachVector(0, this->size(), [&](const T *values, TID first, size_t n) {
+            const_cast<ColumnBaseTyped<T> &>(column).decode(first, n, other_values.get());
+            equal = equal && std::equal(values, values + n, other_values.get());
+        });
+        return equal;
     }
 
     template<class Type>
-    bool ColumnBaseTyped<Type>::add(const ColumnType &new_value) {
+    template<class Operation>
+    bool ColumnBaseTyped<Type>::apply(const ColumnType &new_value, Operation operation) {
         if (std::holds_alternative<std::monostate>(new_value))
             return false;
 
         auto value = std::get<Type>(new_value);
-
-        for (unsigned int i = 0; i < this->size(); i++) {
-            this->update(i, this->operator[](i) + value);
-        }
+        forEachVector(0, this->size(), [&](const Type *values, TID first, size_t n) {
+            for (size_t i = 0; i < n; i++)
+                this->update(static_cast<TID>(first + i), static_cast<Type>(operation(values[i], value)));
+        });
         return true;
     }
 
     template<class Type>
-    bool ColumnBaseTyped<Type>::add(ColumnBase &column) {
-        // std::transform ( first, first+5, second, results, std::plus<int>() );
+    template<class Operation>
+    bool ColumnBaseTyped<Type>::apply(ColumnBase &column, Operation operation) {
         auto &typed_column = dynamic_cast<ColumnBaseTyped<Type> &>(column);
+        if (typed_column.size() != this->size())
+            return false;
 
-        for (unsigned int i = 0; i < this->size(); i++) {
-            this->update(i, this->operator[](i) + typed_column[i]);
-        }
+        auto other_values = std::make_unique<Type[]>(std::min(VECTOR_SIZE, this->size()));
+        forEachVector(0, this->size(), [&](const Type *values, TID first, size_t n) {
+            typed_column.decode(first, n, other_values.get());
+            for (size_t i = 0; i < n; i++)
+                this->update(static_cast<TID>(first + i), static_cast<Type>(operation(values[i], other_values[i])));
+        });
         return true;
     }
 
     template<class Type>
-    bool ColumnBaseTyped<Type>::minus(const ColumnType &new_value) {
-        // shared_pointer_namespace::shared_ptr<ColumnBaseTyped<Type> > typed_column =
-        // shared_pointer_namespace::static_pointer_cast<ColumnBaseTyped<Type> >(column);
-        if (std::holds_alternative<std::monostate>(new_value))
-            return false;
+    bool ColumnBaseTyped<Type>::add(const ColumnType &new_value) {
+        return apply(new_value, std::plus<Type>());
+    }
 
-        auto value = std::get<Type>(new_value);
-        for (unsigned int i = 0; i < this->size(); i++) {
-            this->update(i, this->operator[](i) - value);
-        }
-        return true;
+    template<class Type>
+    bool ColumnBaseTyped<Type>::add(ColumnBase &column) {
+        return apply(column, std::plus<Type>());
     }
 
     template<class Type>
-    bool ColumnBaseTyped<Type>::minus(ColumnBase &column) {
-        // std::transform ( first, first+5, second, results, std::plus<int>() );
-        auto &typed_column = reinterpret_cast<ColumnBaseTyped<Type> &>(column);
+    bool ColumnBaseTyped<Type>::minus(const ColumnType &new_value) {
+        return apply(new_value, std::minus<Type>());
+    }
 
-        for (unsigned int i = 0; i < this->size(); i++) {
-            this->update(i, this->operator[](i) - typed_column[i]);
-        }
-        return true;
+    template<class Type>
+    bool ColumnBaseTyped<Type>::minus(ColumnBase &column) {
+        return apply(column, std::minus<Type>());
     }
 
     template<class Type>
     bool ColumnBaseTyped<Type>::multiply(const ColumnType &new_value) {
-        if (std::holds_alternative<std::monostate>(new_value))
-            return false;
-
-        Type value = std::any_cast<Type>(new_value);
-        for (unsigned int i = 0; i < this->size(); i++) {
-            auto tmp = this->operator[](i) * value;
-            this->update(i, tmp);
-        }
-        return true;
+        return apply(new_value, std::multiplies<Type>());
     }
 
     template<class Type>
     bool ColumnBaseTyped<Type>::multiply(ColumnBase &column) {
-        // std::transform ( first, first+5, second, results, std::plus<int>() );
-        auto &typed_column = dynamic_cast<ColumnBaseTyped<Type> &>(column);
-
-        for (unsigned int i = 0; i < this->size(); i++) {
-            auto tmp = this->operator[](i) * typed_column[i];
-            this->update(i, tmp);
-        }
-        return true;
+        return apply(column, std::multiplies<Type>());
     }
 
     template<class Type>
     bool ColumnBaseTyped<Type>::division(const ColumnType &new_value) {
-        if (std::holds_alternative<std::monostate>(new_value))
-            return false;
-
-        Type value = std::any_cast<Type>(new_value);
         // check that we do not divide by zero
-        if (value == 0)
+        if (std::holds_alternative<Type>(new_value) && std::get<Type>(new_value) == 0)
             return false;
-        for (unsigned int i = 0; i < this->size(); i++) {
-            auto val = this->operator[](i) / value;
-            this->update(i, val);
-        }
-        return true;
+        return apply(new_value, std::divides<Type>());
     }
 
     template<class Type>
     bool ColumnBaseTyped<Type>::division(ColumnBase &column) {
-        // std::transform ( first, first+5, second, results, std::plus<int>() );
-        auto &typed_column = reinterpret_cast<ColumnBaseTyped<Type> &>(column);
-
-        for (unsigned int i = 0; i < this->size(); i++) {
-            auto val = this->operator[](i) / typed_column[i];
-            this->update(i, val);
-        }
-        return true;
+        return apply(column, std::divides<Type>());
     }
 
     // total template specializations, because numeric computations are undefined on strings
@@ -387,6 +779,47 @@ namespace CoGaDB {
         return false;
     }
 
+    // numeric computations are undefined on booleans as well
+    template<>
+    inline bool ColumnBaseTyped<bool>::add(const ColumnType &) {
+        return false;
+    }
+
+    template<>
+    inline bool ColumnBaseTyped<bool>::add(ColumnBase &) {
+        return false;
+    }
+
+    template<>
+    inline bool ColumnBaseTyped<bool>::minus(const ColumnType &) {
+        return false;
+    }
+
+    template<>
+    inline bool ColumnBaseTyped<bool>::minus(ColumnBase &) {
+        return false;
+    }
+
+    template<>
+    inline bool ColumnBaseTyped<bool>::multiply(const ColumnType &) {
+        return false;
+    }
+
+    template<>
+    inline bool ColumnBaseTyped<bool>::multiply(ColumnBase &) {
+        return false;
+    }
+
+    template<>
+    inline bool ColumnBaseTyped<bool>::division(const ColumnType &) {
+        return false;
+    }
+
+    template<>
+    inline bool ColumnBaseTyped<bool>::division(ColumnBase &) {
+        return false;
+    }
+
     template<class T>
     AttributeType ColumnBaseTyped<T>::getType() const {
         if constexpr(std::is_same_v<value_type, int>)
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <algorithm>
+#include <core/global_definitions.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <xmmintrin.h>
+#endif
+
+namespace CoGaDB {
+
+    namespace detail {
+        // hint to load the cache line of address, does nothing on compilers without a prefetch intrinsic
+        inline void prefetch(const void *address) {
+#if defined(__GNUC__)
+            __builtin_prefetch(address);
+#elif defined(_MSC_VER)
+            _mm_prefetch(static_cast<const char *>(address), _MM_HINT_T0);
+#else
+            (void) address;
+#endif
+        }
+    } // namespace detail
+
+    /*! \brief A hash table from keys to TIDs that is built once from all rows of the build input of a hash join.
+     *  \details The table is built in two passes without allocating per row: the first pass hashes every key and
+     * counts the rows per bucket, the second pass writes the rows in bucket order to contiguous arrays of hash tags,
+     * keys and TIDs. The rows of bucket b are the entries [offsets[b], offsets[b + 1]), so a probe scans a short
+     * contiguous range and compares the 32 bit tags before it compares keys. Batched probes prefetch the buckets of
+     * later keys while the current key is compared.*/
+    template<class Key>
+    class FlatHashTable {
+    public:
+        /*! \brief builds the table for the n rows keys[0, n), row i gets TID i */
+        FlatHashTable(const Key *keys, size_t n);
+
+        /*! \brief calls emit(i, tid) for every pair of a probe key keys[i] and a row of the table with the same key
+         *  \details The matches of a key are emitted in the TID order of the build input.*/
+        template<class Function>
+        void probe(const Key *keys, size_t n, Function emit) const;
+
+        [[nodiscard]] size_t size() const noexcept;
+
+        [[nodiscard]] size_t getSizeInBytes() const noexcept;
+
+        /*! \brief scrambles the bits of std::hash, which is the identity for integers, with the finalizer of MurmurHash3
+         *  \details The buckets are selected by the lowest bits of the hash, the tags are the upper 32 bits.*/
+        static uint64_t hash(const Key &key);
+
+    private:
+        // number of keys that are hashed and prefetched ahead of the key that is compared
+        static constexpr size_t PREFETCH_DISTANCE = 16;
+
+        // number of probe keys whose hashes are computed at once
+        static constexpr size_t BATCH_SIZE = 1024;
+
+        uint64_t bucket_mask;           // number of buckets - 1, the number of buckets is a power of two
+        std::vector<uint32_t> offsets;  // the rows of bucket b are the entries [offsets[b], offsets[b + 1])
+        std::vector<uint32_t> tags;     // upper 32 bits of the hash of every entry
+        std::vector<Key> keys;
+        std::vector<TID> tids;
+
+        [[nodiscard]] size_t bucketOf(uint64_t hash) const;
+
+        static uint32_t tagOf(uint64_t hash);
+    };
+
+    /***************** Start of Implementation Section ******************/
+
+    template<class Key>
+    FlatHashTable<Key>::FlatHashTable(const Key *input, const size_t n) : bucket_mask(0), offsets(), tags(), keys(),
+                                                                          tids() {
+        size_t number_of_buckets = 1;
+        while (number_of_buckets < n)
+            number_of_buckets *= 2;
+        bucket_mask = number_of_buckets - 1;
+
+        std::vector<uint64_t> hashes(n);
+        offsets.assign(number_of_buckets + 1, 0);
+        for (size_t i = 0; i < n; i++) {
+            hashes[i] = hash(input[i]);
+            offsets[bucketOf(hashes[i]) + 1]++;
+        }
+        for (size_t bucket = 0; bucket < number_of_buckets; bucket++)
+            offsets[bucket + 1] += offsets[bucket];
+
+        // the rows are written in TID order, so every bucket lists its rows in TID order
+        std::vector<uint32_t> positions(offsets.begin(), offsets.end() - 1);
+        tags.resize(n);
+        keys.resize(n);
+        tids.resize(n);
+        for (size_t i = 0; i < n; i++) {
+            uint32_t position = positions[bucketOf(hashes[i])]++;
+            tags[position] = tagOf(hashes[i]);
+            keys[position] = input[i];
+            tids[position] = static_cast<TID>(i);
+        }
+    }
+
+    template<class Key>
+    template<class Function>
+    void FlatHashTable<Key>::probe(const Key *probe_keys, const size_t n, Function emit) const {
+        uint64_t hashes[BATCH_SIZE];
+        for (size_t batch = 0; batch < n; batch += BATCH_SIZE) {
+            const size_t batch_size = std::min(BATCH_SIZE, n - batch);
+            for (size_t i = 0; i < batch_size; i++) {
+                hashes[i] = hash(probe_keys[batch + i]);
+                detail::prefetch(&offsets[bucketOf(hashes[i])]);
+            }
+
+            for (size_t i = 0; i < batch_size; i++) {
+                if (i + PREFETCH_DISTANCE < batch_size) {
+                    size_t entry = offsets[bucketOf(hashes[i + PREFETCH_DISTANCE])];
+                    if (entry < tags.size()) {
+                        detail::prefetch(&tags[entry]);
+                        detail::prefetch(&tids[entry]);
+                    }
+                }
+
+                const size_t bucket = bucketOf(hashes[i]);
+                const uint32_t tag = tagOf(hashes[i]);
+                const Key &key = probe_keys[batch + i];
+                for (size_t entry = offsets[bucket]; entry < offsets[bucket + 1]; entry++) {
+                    if (tags[entry] == tag && keys[entry] == key)
+                        emit(batch + i, tids[entry]);
+                }
+            }
+        }
+    }
+
+    template<class Key>
+    size_t FlatHashTable<Key>::size() const noexcept {
+        return tids.size();
+    }
+
+    template<class Key>
+    size_t FlatHashTable<Key>::getSizeInBytes() const noexcept {
+        return offsets.size() * sizeof(uint32_t) + tags.size() * sizeof(uint32_t) + keys.size() * sizeof(Key) +
+               tids.size() * sizeof(TID);
+    }
+
+    template<class Key>
+    uint64_t FlatHashTable<Key>::hash(const Key &key) {
+        uint64_t bits = std::hash<Key>()(key);
+        bits ^= bits >> 33;
+        bits *= 0xff51afd7ed558ccdULL;
+        bits ^= bits >> 33;
+        bits *= 0xc4ceb9fe1a85ec53ULL;
+        bits ^= bits >> 33;
+        return bits;
+    }
+
+    template<class Key>
+    size_t FlatHashTable<Key>::bucketOf(const uint64_t hash) const {
+        return static_cast<size_t>(hash & bucket_mask);
+    }
+
+    template<class Key>
+    uint32_t FlatHashTable<Key>::tagOf(const uint64_t hash) {
+        return static_cast<uint32_t>(hash >> 32);
+    }
+
+} // namespace CoGaDB
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+namespace CoGaDB {
+
+    /*! \brief calls function(task) for every task in [0, number_of_tasks), each task on its own thread
+     *  \details The first task runs on the calling thread. The call returns after all tasks finished.*/
+    template<class Function>
+    void parallel_for(size_t number_of_tasks, Function function) {
+        std::vector<std::thread> workers;
+        workers.reserve(number_of_tasks > 0 ? number_of_tasks - 1 : 0);
+        for (size_t task = 1; task < number_of_tasks; ++task)
+            workers.emplace_back(function, task);
+        if (number_of_tasks > 0)
+            function(size_t(0));
+        for (auto &worker: workers)
+            worker.join();
+    }
+
+    /*! \brief sorts [first, last) stably with up to number_of_threads threads
+     *  \details The range is split into one chunk per thread, which are sorted in parallel. Then the chunks are merged
+     * by a parallel multiway merge: splitters sampled from the sorted chunks divide the values into one part per
+     * thread, lower_bound finds the rows of every part in every chunk, and every thread merges the rows of its part
+     * from all chunks at once into a buffer. Equal values fall into the same part and are taken from the chunks in
+     * chunk order, so the sort is stable. Ranges too small to be worth a thread are sorted on the calling thread.*/
+    template<class RandomIt, class Compare>
+    void parallel_sort(RandomIt first, RandomIt last, Compare comp, size_t number_of_threads) {
+        using Value = typename std::iterator_traits<RandomIt>::value_type;
+        constexpr size_t MIN_CHUNK_SIZE = 4096;
+        const auto n = static_cast<size_t>(std::distance(first, last));
+        const size_t number_of_chunks = std::max<size_t>(1, std::min(number_of_threads, n / MIN_CHUNK_SIZE));
+
+        std::vector<RandomIt> bounds(number_of_chunks + 1);
+        for (size_t chunk = 0; chunk <= number_of_chunks; ++chunk)
+            bounds[chunk] = first + static_cast<std::ptrdiff_t>(n * chunk / number_of_chunks);
+
+        parallel_for(number_of_chunks, [&](size_t chunk) {
+            std::stable_sort(bounds[chunk], bounds[chunk + 1], comp);
+        });
+        if (number_of_chunks == 1)
+            return;
+
+        // number_of_chunks evenly spaced samples of every chunk, every number_of_chunks-th sample is a splitter
+        std::vector<Value> samples;
+        for (size_t chunk = 0; chunk < number_of_chunks; ++chunk) {
+            const auto chunk_size = static_cast<size_t>(bounds[chunk + 1] - bounds[chunk]);
+            for (size_t sample = 0; sample < number_of_chunks; ++sample)
+                samples.push_back(bounds[chunk][static_cast<std::ptrdiff_t>(chunk_size * sample / number_of_chunks)]);
+        }
+        std::sort(samples.begin(), samples.end(), comp);
+
+        // the rows of part p in chunk c are [part_bounds[c][p], part_bounds[c][p + 1])
+        const size_t number_of_parts = number_of_chunks;
+        std::vector<std::vector<RandomIt>> part_bounds(number_of_chunks, std::vector<RandomIt>(number_of_parts + 1));
+        parallel_for(number_of_chunks, [&](size_t chunk) {
+            part_bounds[chunk][0] = bounds[chunk];
+            part_bounds[chunk][number_of_parts] = bounds[chunk + 1];
+            for (size_t part = 1; part < number_of_parts; ++part)
+                part_bounds[chunk][part] = std::lower_bound(bounds[chunk], bounds[chunk + 1],
+                                                            samples[part * number_of_chunks], comp);
+        });
+
+        std::vector<size_t> part_offsets(number_of_parts + 1, 0);
+        for (size_t part = 0; part < number_of_parts; ++part) {
+            part_offsets[part + 1] = part_offsets[part];
+            for (size_t chunk = 0; chunk < number_of_chunks; ++chunk)
+                part_offsets[part + 1] += static_cast<size_t>(part_bounds[chunk][part + 1] - part_bounds[chunk][part]);
+        }
+
+        std::vector<Value> buffer(n);
+        parallel_for(number_of_parts, [&](size_t part) {
+            // min heap of the chunks by their next row, ties are taken from the lower chunk first
+            std::vector<RandomIt> heads(number_of_chunks);
+            std::vector<size_t> heap;
+            for (size_t chunk = 0; chunk < number_of_chunks; ++chunk) {
+                heads[chunk] = part_bounds[chunk][part];
+                if (heads[chunk] != part_bounds[chunk][part + 1])
+                    heap.push_back(chunk);
+            }
+            auto later = [&](size_t a, size_t b) {
+                return comp(*heads[b], *heads[a]) || (!comp(*heads[a], *heads[b]) && b < a);
+            };
+            std::make_heap(heap.begin(), heap.end(), later);
+
+            auto out = buffer.begin() + static_cast<std::ptrdiff_t>(part_offsets[part]);
+            while (!heap.empty()) {
+                std::pop_heap(heap.begin(), heap.end(), later);
+                const size_t chunk = heap.back();
+                *out++ = std::move(*heads[chunk]++);
+                if (heads[chunk] == part_bounds[chunk][part + 1])
+                    heap.pop_back();
+                else
+                    std::push_heap(heap.begin(), heap.end(), later);
+            }
+        });
+
+        // the parts are moved back once all threads finished reading the chunks
+        parallel_for(number_of_parts, [&](size_t part) {
+            std::move(buffer.begin() + static_cast<std::ptrdiff_t>(part_offsets[part]),
+                      buffer.begin() + static_cast<std::ptrdiff_t>(part_offsets[part + 1]),
+                      first + static_cast<std::ptrdiff_t>(part_offsets[part]));
+        });
+    }
+
+} // namespace CoGaDB
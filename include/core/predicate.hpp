@@ -0,0 +1,44 @@
+#pragma once
+
+#include <core/global_definitions.hpp>
+
+namespace CoGaDB {
+
+    /*! \brief the predicate (a comp b) with the comparator fixed at compile time
+     *  \details Any value of comp other than EQUAL, LESSER and GREATER is false for all values, like the comparisons
+     * on a runtime ValueComparator.*/
+    template<ValueComparator comp>
+    struct Predicate {
+        static constexpr ValueComparator comparator = comp;
+
+        template<class T>
+        constexpr bool operator()(const T &a, const T &b) const {
+            if constexpr (comp == EQUAL)
+                return a == b;
+            else if constexpr (comp == LESSER)
+                return a < b;
+            else if constexpr (comp == GREATER)
+                return a > b;
+            else
+                return false;
+        }
+    };
+
+    /*! \brief calls function(Predicate<comp>()) and returns its result
+     *  \details Scans call this once before their loops, so the loops are instantiated for every comparator and
+     * function does not test comp for every row.*/
+    template<class Function>
+    decltype(auto) with_predicate(ValueComparator comp, Function &&function) {
+        switch (comp) {
+            case EQUAL:
+                return function(Predicate<EQUAL>());
+            case LESSER:
+                return function(Predicate<LESSER>());
+            case GREATER:
+                return function(Predicate<GREATER>());
+        }
+        // not a valid comparator, the predicate rejects all rows
+        return function(Predicate<static_cast<ValueComparator>(3)>());
+    }
+
+} // namespace CoGaDB
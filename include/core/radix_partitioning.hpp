@@ -0,0 +1,186 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <core/global_definitions.hpp>
+#include <core/hash_table.hpp>
+#include <core/parallel.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/*! \brief Splits the inputs of a hash join into partitions by bits of the hash of their keys.
+ *  \details Rows with equal keys end up in the partitions with the same number on both sides, so a join only has to
+ * join the pairs of partitions with the same number, whose hash tables fit into the cache. The partition is selected
+ * by the hash bits starting at PARTITION_SHIFT, the hash tables of the partitions select their buckets by the bits
+ * below.*/
+namespace CoGaDB::radix_partitioning {
+
+    /*! \brief lowest bit of FlatHashTable<Key>::hash that selects the partition */
+    constexpr unsigned PARTITION_SHIFT = 16;
+
+    /*! \brief number of bits a single pass partitions on, 2^8 partitions per pass keep the write combining buffers in
+     * the L1 cache and the output streams within the TLB */
+    constexpr unsigned BITS_PER_PASS = 8;
+
+    /*! \brief the inputs are partitioned in at most two passes */
+    constexpr unsigned MAX_BITS = 2 * BITS_PER_PASS;
+
+    /*! \brief number of rows of a build partition whose hash table fits into the L2 cache */
+    constexpr size_t PARTITION_ROWS = 16384;
+
+    /*! \brief the rows of a join input split into partitions, partition p are the rows [offsets[p], offsets[p + 1]) of
+     * keys and tids in TID order */
+    template<class Key>
+    struct Partitions {
+        std::unique_ptr<Key[]> keys;
+        std::vector<TID> tids;
+        std::vector<size_t> offsets;
+    };
+
+    /*! \brief number of bits to partition on so that a build input of n rows is split into partitions of at most
+     * PARTITION_ROWS rows, if their keys are distinct */
+    inline unsigned required_bits(size_t n) {
+        unsigned bits = 0;
+        while (bits < MAX_BITS && (n >> bits) > PARTITION_ROWS)
+            bits++;
+        return bits;
+    }
+
+    /*! \brief the partition of key among the 2^bits partitions */
+    template<class Key>
+    size_t partition_of(const Key &key, unsigned bits) {
+        return static_cast<size_t>(FlatHashTable<Key>::hash(key) >> PARTITION_SHIFT) & ((size_t(1) << bits) - 1);
+    }
+
+    namespace detail {
+        // rows a write combining buffer holds, one cache line of TIDs
+        constexpr size_t BUFFER_SIZE = 64 / sizeof(TID);
+
+        // inputs smaller than this are partitioned by a single thread
+        constexpr size_t MIN_CHUNK_SIZE = 16384;
+
+        // counts the rows [begin, end) per partition among fanout partitions, which are selected by the hash bits
+        // starting at PARTITION_SHIFT + shift, and stores the partition of row i in partitions[i]
+        template<class Key>
+        void histogram(const Key *keys, size_t begin, size_t end, unsigned shift, size_t fanout, uint16_t *partitions,
+                       size_t *counts) {
+            for (size_t i = begin; i < end; i++) {
+                auto partition = static_cast<uint16_t>((FlatHashTable<Key>::hash(keys[i]) >> (PARTITION_SHIFT + shift)) &
+                                                       (fanout - 1));
+                partitions[i] = partition;
+                counts[partition]++;
+            }
+        }
+
+        // writes the rows [begin, end) to positions[partitions[i]], the next free position of their partition, and
+        // advances it. The rows are collected in a buffer of one cache line per partition first, so the output is
+        // written in whole cache lines. Row i has TID i if tids is a null pointer.
+        template<class Key>
+        void scatter(const Key *keys, const TID *tids, size_t begin, size_t end, const uint16_t *partitions,
+                     std::vector<size_t> &positions, Key *out_keys, TID *out_tids) {
+            const size_t fanout = positions.size();
+            auto buffered_keys = std::make_unique<Key[]>(fanout * BUFFER_SIZE);
+            std::vector<TID> buffered_tids(fanout * BUFFER_SIZE);
+            std::vector<uint8_t> fill(fanout, 0);
+
+            auto flush = [&](size_t partition, size_t count) {
+                const size_t slot = partition * BUFFER_SIZE;
+                std::copy_n(std::make_move_iterator(buffered_keys.get() + slot), count, out_keys + positions[partition]);
+                std::copy_n(buffered_tids.begin() + slot, count, out_tids + positions[partition]);
+                positions[partition] += count;
+            };
+
+            for (size_t i = begin; i < end; i++) {
+                const size_t partition = partitions[i];
+                const size_t slot = partition * BUFFER_SIZE + fill[partition];
+                buffered_keys[slot] = keys[i];
+                buffered_tids[slot] = tids ? tids[i] : static_cast<TID>(i);
+                if (++fill[partition] == BUFFER_SIZE) {
+                    flush(partition, BUFFER_SIZE);
+                    fill[partition] = 0;
+                }
+            }
+            for (size_t partition = 0; partition < fanout; partition++)
+                flush(partition, fill[partition]);
+        }
+    } // namespace detail
+
+    /*! \brief splits the n rows keys[0, n), row i has TID i, into the 2^bits partitions of partition_of
+     *  \details The first pass partitions on the upper bits: every thread counts the rows of a contiguous chunk per
+     * partition, the prefix sum over the partitions and then the chunks gives every thread its own output positions,
+     * and the threads scatter their chunks through write combining buffers. If bits exceeds BITS_PER_PASS, a second
+     * pass partitions every partition of the first pass on the lower bits, the partitions are handed out to the
+     * threads one at a time. Both passes keep the rows of every partition in TID order.*/
+    template<class Key>
+    Partitions<Key> partition(const Key *keys, size_t n, unsigned bits, unsigned int number_of_threads) {
+        const unsigned second_pass_bits = bits > BITS_PER_PASS ? bits / 2 : 0;
+        const unsigned first_pass_bits = bits - second_pass_bits;
+        const size_t fanout = size_t(1) << first_pass_bits;
+
+        Partitions<Key> result;
+        result.keys = std::make_unique<Key[]>(n);
+        result.tids.resize(n);
+        std::unique_ptr<Key[]> first_pass_keys;
+        std::vector<TID> first_pass_tids;
+        if (second_pass_bits > 0) {
+            first_pass_keys = std::make_unique<Key[]>(n);
+            first_pass_tids.resize(n);
+        }
+        Key *out_keys = second_pass_bits > 0 ? first_pass_keys.get() : result.keys.get();
+        TID *out_tids = second_pass_bits > 0 ? first_pass_tids.data() : result.tids.data();
+
+        std::vector<uint16_t> partitions(n);
+        const size_t number_of_chunks = std::max<size_t>(1, std::min<size_t>(number_of_threads, n / detail::MIN_CHUNK_SIZE));
+        std::vector<std::vector<size_t>> positions(number_of_chunks, std::vector<size_t>(fanout, 0));
+        parallel_for(number_of_chunks, [&](size_t chunk) {
+            detail::histogram(keys, n * chunk / number_of_chunks, n * (chunk + 1) / number_of_chunks, second_pass_bits,
+                              fanout, partitions.data(), positions[chunk].data());
+        });
+
+        // the rows of a partition are ordered by chunk, so they stay in TID order
+        std::vector<size_t> offsets(fanout + 1, n);
+        size_t offset = 0;
+        for (size_t partition = 0; partition < fanout; partition++) {
+            offsets[partition] = offset;
+            for (size_t chunk = 0; chunk < number_of_chunks; chunk++)
+                offset += std::exchange(positions[chunk][partition], offset);
+        }
+
+        parallel_for(number_of_chunks, [&](size_t chunk) {
+            detail::scatter(keys, static_cast<const TID *>(nullptr), n * chunk / number_of_chunks,
+                            n * (chunk + 1) / number_of_chunks, partitions.data(), positions[chunk], out_keys, out_tids);
+        });
+
+        if (second_pass_bits == 0) {
+            result.offsets = std::move(offsets);
+            return result;
+        }
+
+        const size_t second_pass_fanout = size_t(1) << second_pass_bits;
+        result.offsets.assign(fanout * second_pass_fanout + 1, n);
+        std::atomic<size_t> next_partition(0);
+        parallel_for(std::min<size_t>(std::max(number_of_threads, 1u), fanout), [&](size_t) {
+            std::vector<size_t> sub_positions(second_pass_fanout);
+            for (size_t partition = next_partition++; partition < fanout; partition = next_partition++) {
+                const size_t begin = offsets[partition], end = offsets[partition + 1];
+                std::fill(sub_positions.begin(), sub_positions.end(), 0);
+                detail::histogram(out_keys, begin, end, 0, second_pass_fanout, partitions.data(), sub_positions.data());
+
+                size_t sub_offset = begin;
+                for (size_t sub_partition = 0; sub_partition < second_pass_fanout; sub_partition++) {
+                    result.offsets[partition * second_pass_fanout + sub_partition] = sub_offset;
+                    sub_offset += std::exchange(sub_positions[sub_partition], sub_offset);
+                }
+                detail::scatter(static_cast<const Key *>(out_keys), static_cast<const TID *>(out_tids), begin, end,
+                                partitions.data(), sub_positions, result.keys.get(), result.tids.data());
+            }
+        });
+
+        return result;
+    }
+
+} // namespace CoGaDB::radix_partitioning
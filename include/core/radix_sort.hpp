@@ -0,0 +1,94 @@
+#pragma once
+
+#include <core/base_column.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace CoGaDB {
+
+    namespace detail {
+        // maps the values to unsigned keys with the same order: the sign bit of integers is flipped, negative floats
+        // have all bits flipped, positive floats only the sign bit
+        inline uint32_t radix_key(int value) {
+            return static_cast<uint32_t>(value) ^ 0x80000000u;
+        }
+
+        inline uint32_t radix_key(float value) {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            // -0.0 equals 0.0, so it is ordered by TID like equal values
+            if (bits == 0x80000000u)
+                bits = 0;
+            return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+        }
+    } // namespace detail
+
+    /*! \brief the TIDs of the rows values[0, n) ordered by value, rows with equal values in TID order
+     *  \details A least significant digit radix sort over the 11 bit digits of the radix key in three passes. The rows
+     * are sorted as 64 bit words with the key in the upper and the TID in the lower half. The histograms of all passes
+     * are counted in a single pass over the values, passes whose digit is the same for all rows are skipped, the first
+     * pass reads the values directly and the last pass only writes the TIDs. Every pass is stable, so equal values
+     * stay in TID order.*/
+    template<class T>
+    PositionList radix_sort(const T *values, size_t n) {
+        constexpr unsigned DIGIT_BITS = 11;
+        constexpr size_t RADIX = size_t(1) << DIGIT_BITS;
+        constexpr size_t NUMBER_OF_PASSES = (32 + DIGIT_BITS - 1) / DIGIT_BITS;
+
+        std::vector<size_t> histograms(NUMBER_OF_PASSES * RADIX, 0);
+        for (size_t i = 0; i < n; i++) {
+            uint32_t key = detail::radix_key(values[i]);
+            for (size_t pass = 0; pass < NUMBER_OF_PASSES; pass++)
+                histograms[pass * RADIX + ((key >> (DIGIT_BITS * pass)) & (RADIX - 1))]++;
+        }
+
+        std::vector<size_t> passes;
+        for (size_t pass = 0; pass < NUMBER_OF_PASSES && n > 0; pass++) {
+            uint32_t key = detail::radix_key(values[0]);
+            if (histograms[pass * RADIX + ((key >> (DIGIT_BITS * pass)) & (RADIX - 1))] != n)
+                passes.push_back(pass);
+        }
+
+        PositionList tids(n);
+        if (passes.empty()) {
+            for (size_t i = 0; i < n; i++)
+                tids[i] = static_cast<TID>(i);
+            return tids;
+        }
+
+        std::vector<uint64_t> rows, buffer;
+        for (size_t pass: passes) {
+            size_t *offsets = &histograms[pass * RADIX];
+            for (size_t digit = 0, offset = 0; digit < RADIX; digit++)
+                offset += std::exchange(offsets[digit], offset);
+
+            const bool last = pass == passes.back();
+            const unsigned shift = static_cast<unsigned>(32 + DIGIT_BITS * pass);
+            auto scatter = [&](auto row_of) {
+                if (last) {
+                    for (size_t i = 0; i < n; i++) {
+                        uint64_t row = row_of(i);
+                        tids[offsets[(row >> shift) & (RADIX - 1)]++] = static_cast<TID>(row);
+                    }
+                } else {
+                    buffer.resize(n);
+                    for (size_t i = 0; i < n; i++) {
+                        uint64_t row = row_of(i);
+                        buffer[offsets[(row >> shift) & (RADIX - 1)]++] = row;
+                    }
+                    rows.swap(buffer);
+                }
+            };
+            if (pass == passes.front())
+                scatter([&](size_t i) { return (uint64_t(detail::radix_key(values[i])) << 32) | i; });
+            else
+                scatter([&](size_t i) { return rows[i]; });
+        }
+
+        return tids;
+    }
+
+} // namespace CoGaDB
@@ -0,0 +1,365 @@
+#pragma once
+
+#include <core/global_definitions.hpp>
+#include <core/predicate.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*! \brief Vectorized kernels shared by the column implementations.
+ *  \details Every kernel has a scalar fallback. The SIMD code paths are selected at compile time, depending on the
+ * instruction sets that are enabled for the target.*/
+namespace CoGaDB::simd {
+
+    static_assert(sizeof(TID) == sizeof(uint32_t), "the kernels assume 32 bit TIDs");
+
+    namespace detail {
+        // number of set bits of a comparison mask
+        inline unsigned popcount(unsigned mask) {
+#if defined(__GNUC__)
+            return static_cast<unsigned>(__builtin_popcount(mask));
+#else
+            unsigned count = 0;
+            for (; mask != 0; mask &= mask - 1)
+                ++count;
+            return count;
+#endif
+        }
+
+#if defined(__SSE2__)
+        template<ValueComparator comp>
+        inline int compare_mask(const int *values, int value) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(values));
+            __m128i c = _mm_set1_epi32(value);
+            __m128i mask;
+            if constexpr (comp == EQUAL)
+                mask = _mm_cmpeq_epi32(v, c);
+            else if constexpr (comp == LESSER)
+                mask = _mm_cmplt_epi32(v, c);
+            else if constexpr (comp == GREATER)
+                mask = _mm_cmpgt_epi32(v, c);
+            else
+                mask = _mm_setzero_si128();
+            return _mm_movemask_ps(_mm_castsi128_ps(mask));
+        }
+
+        template<ValueComparator comp>
+        inline int compare_mask(const float *values, float value) {
+            __m128 v = _mm_loadu_ps(values);
+            __m128 c = _mm_set1_ps(value);
+            __m128 mask;
+            if constexpr (comp == EQUAL)
+                mask = _mm_cmpeq_ps(v, c);
+            else if constexpr (comp == LESSER)
+                mask = _mm_cmplt_ps(v, c);
+            else if constexpr (comp == GREATER)
+                mask = _mm_cmpgt_ps(v, c);
+            else
+                mask = _mm_setzero_ps();
+            return _mm_movemask_ps(mask);
+        }
+#endif
+
+#if defined(__AVX512F__)
+        template<ValueComparator comp>
+        inline __mmask16 compare_mask16(const int *values, int value) {
+            __m512i v = _mm512_loadu_si512(values);
+            __m512i c = _mm512_set1_epi32(value);
+            if constexpr (comp == EQUAL)
+                return _mm512_cmpeq_epi32_mask(v, c);
+            if constexpr (comp == LESSER)
+                return _mm512_cmplt_epi32_mask(v, c);
+            if constexpr (comp == GREATER)
+                return _mm512_cmpgt_epi32_mask(v, c);
+            return 0;
+        }
+
+        template<ValueComparator comp>
+        inline __mmask16 compare_mask16(const float *values, float value) {
+            __m512 v = _mm512_loadu_ps(values);
+            __m512 c = _mm512_set1_ps(value);
+            if constexpr (comp == EQUAL)
+                return _mm512_cmp_ps_mask(v, c, _CMP_EQ_OQ);
+            if constexpr (comp == LESSER)
+                return _mm512_cmp_ps_mask(v, c, _CMP_LT_OQ);
+            if constexpr (comp == GREATER)
+                return _mm512_cmp_ps_mask(v, c, _CMP_GT_OQ);
+            return 0;
+        }
+#elif defined(__AVX2__)
+        template<ValueComparator comp>
+        inline unsigned compare_mask8(const int *values, int value) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values));
+            __m256i c = _mm256_set1_epi32(value);
+            __m256i mask;
+            if constexpr (comp == EQUAL)
+                mask = _mm256_cmpeq_epi32(v, c);
+            else if constexpr (comp == LESSER)
+                mask = _mm256_cmpgt_epi32(c, v);
+            else if constexpr (comp == GREATER)
+                mask = _mm256_cmpgt_epi32(v, c);
+            else
+                mask = _mm256_setzero_si256();
+            return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(mask)));
+        }
+
+        template<ValueComparator comp>
+        inline unsigned compare_mask8(const float *values, float value) {
+            __m256 v = _mm256_loadu_ps(values);
+            __m256 c = _mm256_set1_ps(value);
+            __m256 mask;
+            if constexpr (comp == EQUAL)
+                mask = _mm256_cmp_ps(v, c, _CMP_EQ_OQ);
+            else if constexpr (comp == LESSER)
+                mask = _mm256_cmp_ps(v, c, _CMP_LT_OQ);
+            else if constexpr (comp == GREATER)
+                mask = _mm256_cmp_ps(v, c, _CMP_GT_OQ);
+            else
+                mask = _mm256_setzero_ps();
+            return static_cast<unsigned>(_mm256_movemask_ps(mask));
+        }
+
+        // entry m lists the positions of the set bits of the 8 bit mask m in ascending order, one byte each
+        struct CompressTable {
+            uint64_t entries[256];
+        };
+
+        constexpr CompressTable make_compress_table() {
+            CompressTable table{};
+            for (unsigned mask = 0; mask < 256; ++mask) {
+                unsigned count = 0;
+                for (unsigned lane = 0; lane < 8; ++lane) {
+                    if (mask & (1u << lane))
+                        table.entries[mask] |= uint64_t(lane) << (8 * count++);
+                }
+            }
+            return table;
+        }
+
+        inline constexpr CompressTable compress_table = make_compress_table();
+#endif
+
+#if defined(__AVX2__)
+        inline unsigned equal_mask8(const int *a, const int *b) {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a));
+            __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b));
+            return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(x, y))));
+        }
+
+        inline unsigned equal_mask8(const float *a, const float *b) {
+            __m256 x = _mm256_loadu_ps(a);
+            __m256 y = _mm256_loadu_ps(b);
+            return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(x, y, _CMP_EQ_OQ)));
+        }
+#endif
+
+#if defined(__SSE2__)
+        inline unsigned equal_mask4(const int *a, const int *b) {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a));
+            __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b));
+            return static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(x, y))));
+        }
+
+        inline unsigned equal_mask4(const float *a, const float *b) {
+            return static_cast<unsigned>(_mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(a), _mm_loadu_ps(b))));
+        }
+#endif
+    } // namespace detail
+
+    /*! \brief sums up n run lengths
+     *  \return the number of rows described by the runs*/
+    inline size_t sum_run_lengths(const uint8_t *lengths, size_t n) {
+        size_t i = 0, total = 0;
+#if defined(__SSE2__)
+        const __m128i zero = _mm_setzero_si128();
+        __m128i acc = zero;
+        for (; i + 16 <= n; i += 16) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(lengths + i));
+            acc = _mm_add_epi64(acc, _mm_sad_epu8(v, zero));
+        }
+        uint64_t partial[2];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(partial), acc);
+        total = partial[0] + partial[1];
+#endif
+        for (; i < n; ++i)
+            total += lengths[i];
+        return total;
+    }
+
+    /*! \brief computes the TID of the first row of every run, which is the exclusive prefix sum of the run lengths
+     *  \return the number of rows described by the runs*/
+    inline size_t prefix_sum_run_lengths(const uint8_t *lengths, size_t n, TID *starts) {
+        size_t i = 0;
+        TID carry = 0;
+#if defined(__SSE2__)
+        const __m128i zero = _mm_setzero_si128();
+        __m128i offset = zero;
+        for (; i + 4 <= n; i += 4) {
+            uint32_t packed;
+            std::memcpy(&packed, lengths + i, sizeof(packed));
+            // widen 4 lengths to 32 bit lanes
+            __m128i x = _mm_cvtsi32_si128(static_cast<int>(packed));
+            x = _mm_unpacklo_epi16(_mm_unpacklo_epi8(x, zero), zero);
+            // in register scan: [0, a, a+b, a+b+c] plus the carry of the previous registers
+            __m128i scan = _mm_slli_si128(x, 4);
+            scan = _mm_add_epi32(scan, _mm_slli_si128(scan, 4));
+            scan = _mm_add_epi32(scan, _mm_slli_si128(scan, 8));
+            scan = _mm_add_epi32(scan, offset);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(starts + i), scan);
+            offset = _mm_shuffle_epi32(_mm_add_epi32(scan, x), _MM_SHUFFLE(3, 3, 3, 3));
+        }
+        carry = static_cast<TID>(_mm_cvtsi128_si32(offset));
+#endif
+        for (; i < n; ++i) {
+            starts[i] = carry;
+            carry += lengths[i];
+        }
+        return carry;
+    }
+
+    /*! \brief replaces every value by the inclusive prefix sum of the values up to it, starting from initial
+     *  \details The sums wrap around like unsigned arithmetic, which is exactly what delta decoding needs. Four int
+     * values are scanned in a register at a time.*/
+    template<class T>
+    inline void inclusive_prefix_sum(T *data, size_t n, T initial) {
+        static_assert(std::is_integral_v<T>, "prefix sums are computed on integers");
+        using Unsigned = std::make_unsigned_t<T>;
+
+        size_t i = 0;
+        auto carry = static_cast<Unsigned>(initial);
+#if defined(__SSE2__)
+        if constexpr (sizeof(T) == sizeof(int32_t)) {
+            __m128i offset = _mm_set1_epi32(static_cast<int>(carry));
+            for (; i + 4 <= n; i += 4) {
+                __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+                x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+                x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+                x = _mm_add_epi32(x, offset);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(data + i), x);
+                offset = _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3));
+            }
+            carry = static_cast<Unsigned>(_mm_cvtsi128_si32(offset));
+        }
+#endif
+        for (; i < n; ++i) {
+            carry += static_cast<Unsigned>(data[i]);
+            data[i] = static_cast<T>(carry);
+        }
+    }
+
+    /*! \brief evaluates the predicate (values[i] comp value) for n values
+     *  \details matches[i] is set to 1 if values[i] fulfills the predicate and to 0 otherwise. int and float values
+     * are compared a whole register at a time. The comparator is dispatched once per call, the loops are instantiated
+     * for every comparator.*/
+    template<class T>
+    inline void evaluate_predicate(const T *values, size_t n, const T &value, ValueComparator comp, uint8_t *matches) {
+        with_predicate(comp, [&](auto predicate) {
+            size_t i = 0;
+#if defined(__SSE2__)
+            if constexpr (std::is_same_v<T, int> || std::is_same_v<T, float>) {
+                for (const size_t vector_end = n - n % 4; i < vector_end; i += 4) {
+                    int mask = detail::compare_mask<decltype(predicate)::comparator>(values + i, value);
+                    matches[i] = mask & 1;
+                    matches[i + 1] = (mask >> 1) & 1;
+                    matches[i + 2] = (mask >> 2) & 1;
+                    matches[i + 3] = (mask >> 3) & 1;
+                }
+            }
+#endif
+            for (; i < n; ++i)
+                matches[i] = predicate(values[i], value);
+        });
+    }
+
+    /*! \brief writes the TIDs first + i of all values[i] that fulfill the predicate (values[i] comp value) to positions
+     *  \details int and float values are compared a register at a time without branching on the result. With AVX-512
+     * the TIDs of the qualifying lanes are written with a compress-store, with AVX2 they are moved to the front of the
+     * register by a permutation from a lookup table indexed by the comparison mask. All other code paths write the TID
+     * of every row and only advance the output position if the row qualifies. Like evaluate_predicate, the loops are
+     * instantiated for every comparator. positions needs room for n entries.
+     *  \return the number of qualifying rows*/
+    template<class T>
+    inline size_t select_positions(const T *values, size_t n, const T &value, ValueComparator comp, TID first,
+                                   TID *positions) {
+        return with_predicate(comp, [&](auto predicate) {
+            size_t i = 0, count = 0;
+            if constexpr (std::is_same_v<T, int> || std::is_same_v<T, float>) {
+#if defined(__AVX512F__)
+                __m512i tids = _mm512_add_epi32(_mm512_set1_epi32(static_cast<int>(first)),
+                                                _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+                for (const size_t vector_end = n - n % 16; i < vector_end; i += 16) {
+                    __mmask16 mask = detail::compare_mask16<decltype(predicate)::comparator>(values + i, value);
+                    _mm512_mask_compressstoreu_epi32(positions + count, mask, tids);
+                    count += detail::popcount(mask);
+                    tids = _mm512_add_epi32(tids, _mm512_set1_epi32(16));
+                }
+#elif defined(__AVX2__)
+                __m256i tids = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(first)),
+                                                _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+                for (const size_t vector_end = n - n % 8; i < vector_end; i += 8) {
+                    unsigned mask = detail::compare_mask8<decltype(predicate)::comparator>(values + i, value);
+                    // all 8 lanes are stored, count <= i keeps the store within the first n entries
+                    __m256i permutation = _mm256_cvtepu8_epi32(
+                            _mm_loadl_epi64(reinterpret_cast<const __m128i *>(&detail::compress_table.entries[mask])));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(positions + count),
+                                        _mm256_permutevar8x32_epi32(tids, permutation));
+                    count += detail::popcount(mask);
+                    tids = _mm256_add_epi32(tids, _mm256_set1_epi32(8));
+                }
+#endif
+#if defined(__SSE2__)
+                for (const size_t vector_end = n - n % 4; i < vector_end; i += 4) {
+                    int mask = detail::compare_mask<decltype(predicate)::comparator>(values + i, value);
+                    for (int lane = 0; lane < 4; ++lane) {
+                        positions[count] = static_cast<TID>(first + i + lane);
+                        count += (mask >> lane) & 1;
+                    }
+                }
+#endif
+            }
+            for (; i < n; ++i) {
+                positions[count] = static_cast<TID>(first + i);
+                count += predicate(values[i], value);
+            }
+            return count;
+        });
+    }
+
+    /*! \brief finds the positions p in [1, n) where a new run starts, i.e., data[p] != data[p - 1]
+     *  \details Adjacent int and float values are compared a register at a time by comparing the input with itself
+     * shifted by one element. The run boundaries are extracted from the comparison mask with tzcnt.
+     *  \return the number of positions written to positions, which needs room for n - 1 entries*/
+    template<class T>
+    inline size_t find_run_boundaries(const T *data, size_t n, uint32_t *positions) {
+        size_t count = 0, i = 1;
+#if defined(__SSE2__)
+        if constexpr (std::is_same_v<T, int> || std::is_same_v<T, float>) {
+#if defined(__AVX2__)
+            for (; i + 8 <= n; i += 8) {
+                unsigned boundaries = ~detail::equal_mask8(data + i - 1, data + i) & 0xFFu;
+                for (; boundaries != 0; boundaries &= boundaries - 1)
+                    positions[count++] = static_cast<uint32_t>(i + __builtin_ctz(boundaries));
+            }
+#endif
+            for (; i + 4 <= n; i += 4) {
+                unsigned boundaries = ~detail::equal_mask4(data + i - 1, data + i) & 0xFu;
+                for (; boundaries != 0; boundaries &= boundaries - 1)
+                    positions[count++] = static_cast<uint32_t>(i + __builtin_ctz(boundaries));
+            }
+        }
+#endif
+        for (; i < n; ++i) {
+            if (!(data[i] == data[i - 1]))
+                positions[count++] = static_cast<uint32_t>(i);
+        }
+        return count;
+    }
+
+} // namespace CoGaDB::simd
@@ -0,0 +1,83 @@
+/*! \file join_benchmark.cpp
+ * Compares hash_join, which builds a single hash table on the smaller column, with the radix partitioned
+ * parallel_hash_join, ordered and unordered, for an increasing number of threads.
+ * Usage: join_benchmark [number of rows] [maximum number of threads], the defaults are 10 million rows per column and
+ * the number of hardware threads.
+ */
+#include "core/column.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+
+using namespace CoGaDB;
+
+namespace {
+
+    // milliseconds of the fastest of three runs of function
+    template<class Function>
+    double measure(Function function) {
+        double best = 0;
+        for (int run = 0; run < 3; run++) {
+            auto start = std::chrono::steady_clock::now();
+            function();
+            std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            if (run == 0 || elapsed.count() < best)
+                best = elapsed.count();
+        }
+        return best;
+    }
+
+    void report(const std::string &name, double milliseconds, double baseline) {
+        std::cout << std::left << std::setw(44) << name << std::right << std::setw(12) << std::fixed
+                  << std::setprecision(1) << milliseconds << " ms" << std::setw(10) << std::setprecision(2)
+                  << baseline / milliseconds << "x" << std::endl;
+    }
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const size_t number_of_rows = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    const unsigned int max_threads = argc > 2 ? static_cast<unsigned int>(std::strtoul(argv[2], nullptr, 10))
+                                              : std::max(1u, std::thread::hardware_concurrency());
+
+    // a key column with distinct values and a foreign key column of the same size that references it uniformly
+    std::mt19937 generator(42);
+    std::vector<int> keys(number_of_rows), foreign_keys(number_of_rows);
+    for (size_t i = 0; i < number_of_rows; i++)
+        keys[i] = static_cast<int>(i);
+    std::shuffle(keys.begin(), keys.end(), generator);
+    std::uniform_int_distribution<size_t> distribution(0, number_of_rows - 1);
+    for (auto &foreign_key: foreign_keys)
+        foreign_key = keys[distribution(generator)];
+
+    Column<int> key_column("key"), foreign_key_column("foreign_key");
+    key_column.insert(keys.begin(), keys.end());
+    foreign_key_column.insert(foreign_keys.begin(), foreign_keys.end());
+
+    size_t expected = 0;
+    double baseline = measure([&] { expected = key_column.hash_join(foreign_key_column).first.size(); });
+    report("hash_join", baseline, baseline);
+
+    for (unsigned int number_of_threads = 1; number_of_threads <= max_threads; number_of_threads *= 2) {
+        for (bool ordered: {true, false}) {
+            size_t matches = 0;
+            double milliseconds = measure([&] {
+                matches = key_column.parallel_hash_join(foreign_key_column, number_of_threads, ordered).first.size();
+            });
+            if (matches != expected) {
+                std::cerr << "parallel_hash_join: " << matches << " pairs instead of " << expected << std::endl;
+                std::exit(EXIT_FAILURE);
+            }
+            report("parallel_hash_join " + std::string(ordered ? "ordered, " : "unordered, ") +
+                           std::to_string(number_of_threads) + " threads",
+                   milliseconds, baseline);
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,115 @@
+/*! \file selection_benchmark.cpp
+ * Compares the selection of the column implementations with the row at a time loop that ColumnBaseTyped used before
+ * the scans were specialized per comparator: one virtual operator[] call and one test of the comparator per row.
+ * Usage: selection_benchmark [number of rows], the default is 10 million rows.
+ */
+#include "core/column.hpp"
+
+#include "compression/dictionary_compressed_column.hpp"
+#include "compression/for_compressed_column.hpp"
+#include "compression/rle_compressed_column.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+using namespace CoGaDB;
+
+namespace {
+
+    template<class T>
+    PositionList row_at_a_time_selection(ColumnBaseTyped<T> &column, const T &value, ValueComparator comp) {
+        PositionList result_tids;
+        for (TID i = 0; i < column.size(); i++) {
+            if (comp == EQUAL) {
+                if (value == column[i])
+                    result_tids.push_back(i);
+            } else if (comp == LESSER) {
+                if (column[i] < value)
+                    result_tids.push_back(i);
+            } else if (comp == GREATER) {
+                if (column[i] > value)
+                    result_tids.push_back(i);
+            }
+        }
+        return result_tids;
+    }
+
+    // milliseconds of the fastest of three runs of function
+    template<class Function>
+    double measure(Function function) {
+        double best = 0;
+        for (int run = 0; run < 3; run++) {
+            auto start = std::chrono::steady_clock::now();
+            function();
+            std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            if (run == 0 || elapsed.count() < best)
+                best = elapsed.count();
+        }
+        return best;
+    }
+
+    template<class T>
+    void benchmark(const std::string &name, ColumnBaseTyped<T> &column, const T &value) {
+        for (auto [comp, comparator]: {std::pair{EQUAL, "EQUAL"}, {LESSER, "LESSER"}, {GREATER, "GREATER"}}) {
+            size_t expected = 0, qualifying_rows = 0;
+            double row_at_a_time = measure([&] { expected = row_at_a_time_selection(column, value, comp).size(); });
+            double specialized = measure([&] { qualifying_rows = column.selection(value, comp).size(); });
+            if (qualifying_rows != expected) {
+                std::cerr << name << " " << comparator << ": " << qualifying_rows << " rows instead of " << expected
+                          << std::endl;
+                std::exit(EXIT_FAILURE);
+            }
+
+            std::cout << std::left << std::setw(28) << name << std::setw(8) << comparator << std::right
+                      << std::setw(12) << std::fixed << std::setprecision(1) << row_at_a_time << " ms"
+                      << std::setw(12) << specialized << " ms" << std::setw(10) << std::setprecision(2)
+                      << row_at_a_time / specialized << "x" << std::endl;
+        }
+    }
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const size_t number_of_rows = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+    // uniformly distributed values, so about half of the rows qualify for LESSER and GREATER
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> distribution(0, 999);
+    std::vector<int> values(number_of_rows);
+    for (auto &value: values)
+        value = distribution(generator);
+    std::vector<float> float_values(values.begin(), values.end());
+    // runs of 16 equal values for the run length encoded column
+    std::vector<int> run_values(number_of_rows);
+    for (size_t i = 0; i < number_of_rows; i++)
+        run_values[i] = values[i / 16];
+
+    std::cout << std::left << std::setw(36) << "column" << std::right << std::setw(15) << "row at a time"
+              << std::setw(15) << "specialized" << std::setw(11) << "speedup" << std::endl;
+
+    Column<int> int_column("int");
+    int_column.insert(values.begin(), values.end());
+    benchmark<int>("Column<int>", int_column, 500);
+
+    Column<float> float_column("float");
+    float_column.insert(float_values.begin(), float_values.end());
+    benchmark<float>("Column<float>", float_column, 500.0f);
+
+    DictionaryCompressedColumn<int> dictionary_column("dictionary");
+    dictionary_column.insert(values.begin(), values.end());
+    benchmark<int>("DictionaryCompressedColumn", dictionary_column, 500);
+
+    FORCompressedColumn<int> for_column("for");
+    for_column.insert(values.begin(), values.end());
+    benchmark<int>("FORCompressedColumn", for_column, 500);
+
+    // the row at a time loop is quadratic on RLE columns, so they get fewer rows
+    RLECompressedColumn<int> rle_column("rle");
+    rle_column.insert(run_values.begin(), run_values.begin() + std::min<size_t>(number_of_rows, 100000));
+    benchmark<int>("RLECompressedColumn (100K)", rle_column, 500);
+
+    return EXIT_SUCCESS;
+}
@@ -2,13 +2,23 @@
 #include "core/column.hpp"
 
 // TODO: include your compressed column implementations here
+#include "compression/alp_compressed_column.hpp"
+#include "compression/bit_vector_compressed_column.hpp"
+#include "compression/boolean_compressed_column.hpp"
+#include "compression/byte_stream_split_compressed_column.hpp"
+#include "compression/delta_compressed_column.hpp"
 #include "compression/dictionary_compressed_column.hpp"
+#include "compression/for_compressed_column.hpp"
+#include "compression/fsst_compressed_column.hpp"
+#include "compression/pfor_compressed_column.hpp"
 #include "compression/rle_compressed_column.hpp"
+#include "compression/xor_compressed_column.hpp"
 
-#include "config.hpp"
 #include "tests/utils.hpp"
 
 #include <catch2/catch.hpp>
+#include <limits>
+#include <tuple>
 
 template <typename T>
 struct Column_Test_Fixture
@@ -18,24 +28,20 @@ struct Column_Test_Fixture
                             col_two(getAttributeString<ValueType>()),
                             reference_data(100){};
 
+    /*! \brief fills col_one with the reference data, then tests copy, update, delete, store and load against it */
+    void test_column_operations();
+
     T col_one;
     T col_two;
     std::vector<ValueType> reference_data;
+    TemporaryDirectory data_directory;
 };
 
 using namespace CoGaDB;
 
-TEMPLATE_PRODUCT_TEST_CASE_METHOD(Column_Test_Fixture,
-                                  "Template test case method with test types specified inside std::tuple",
-                                  "[class][template]",
-                                  (Column, RLECompressedColumn, DictionaryCompressedColumn),
-                                  (int, float, std::string))
+template <typename TestType>
+void Column_Test_Fixture<TestType>::test_column_operations()
 {
-    using ValueType = typename Column_Test_Fixture<TestType>::ValueType;
-    auto &col_one = Column_Test_Fixture<TestType>::col_one;
-    auto &col_two = Column_Test_Fixture<TestType>::col_two;
-    auto &reference_data = Column_Test_Fixture<TestType>::reference_data;
-
     /****** INSERT TEST ******/
     REQUIRE_NOTHROW(fill_column<ValueType>(col_one, reference_data));
 
@@ -49,7 +55,7 @@ TEMPLATE_PRODUCT_TEST_CASE_METHOD(Column_Test_Fixture,
     REQUIRE(cpy == col_one);
 
     /****** UPDATE TEST ******/
-    std::uniform_int_distribution dist(0, 100);
+    std::uniform_int_distribution<TID> dist(0, reference_data.size() - 1);
     TID tid = dist(gen);
     auto new_value = get_rand_value<ValueType>();
 
@@ -67,10 +73,886 @@ TEMPLATE_PRODUCT_TEST_CASE_METHOD(Column_Test_Fixture,
     REQUIRE_THAT(col_one, isEqual<TestType>(reference_data));
 
     /****** STORE AND LOAD TEST ******/
-    REQUIRE_NOTHROW(col_one.store(DATA_PATH));
+    REQUIRE_NOTHROW(col_one.store(data_directory.path()));
     col_one.clearContent();
     REQUIRE(col_one.size() == 0);
 
-    REQUIRE_NOTHROW(col_two.load(DATA_PATH));
+    REQUIRE_NOTHROW(col_two.load(data_directory.path()));
+    REQUIRE_THAT(col_two, isEqual<TestType>(reference_data));
+}
+
+TEMPLATE_PRODUCT_TEST_CASE_METHOD(Column_Test_Fixture,
+                                  "Template test case method with test types specified inside std::tuple",
+                                  "[class][template]",
+                                  (Column, RLECompressedColumn, DictionaryCompressedColumn, BitVectorCompressedColumn),
+                                  (int, float, std::string))
+{
+    Column_Test_Fixture<TestType>::test_column_operations();
+}
+
+TEMPLATE_PRODUCT_TEST_CASE_METHOD(Column_Test_Fixture,
+                                  "Template test case method for boolean columns",
+                                  "[class][template]",
+                                  (Column, RLECompressedColumn, BooleanCompressedColumn),
+                                  (bool))
+{
+    // more rows than fit into one word of the bitmap
+    Column_Test_Fixture<TestType>::reference_data.resize(1000);
+    Column_Test_Fixture<TestType>::test_column_operations();
+
+    /****** ARITHMETIC TEST ******/
+    // numeric computations are undefined on booleans, the column stays untouched
+    auto &col_two = Column_Test_Fixture<TestType>::col_two;
+    auto &reference_data = Column_Test_Fixture<TestType>::reference_data;
+    std::unique_ptr<ColumnBase> other = col_two.copy();
+    REQUIRE_FALSE(col_two.add(true));
+    REQUIRE_FALSE(col_two.add(*other));
+    REQUIRE_FALSE(col_two.minus(true));
+    REQUIRE_FALSE(col_two.minus(*other));
+    REQUIRE_FALSE(col_two.multiply(true));
+    REQUIRE_FALSE(col_two.multiply(*other));
+    REQUIRE_FALSE(col_two.division(true));
+    REQUIRE_FALSE(col_two.division(*other));
     REQUIRE_THAT(col_two, isEqual<TestType>(reference_data));
 }
+
+TEMPLATE_TEST_CASE_METHOD(Column_Test_Fixture,
+                          "Template test case method for integer encodings",
+                          "[class][template]",
+                          DeltaCompressedColumn<int>,
+                          FORCompressedColumn<int>,
+                          PatchedFORCompressedColumn<int>)
+{
+    // more rows than fit into one block of the block based encodings
+    Column_Test_Fixture<TestType>::reference_data.resize(1000);
+    Column_Test_Fixture<TestType>::test_column_operations();
+}
+
+TEMPLATE_TEST_CASE_METHOD(Column_Test_Fixture,
+                          "Template test case method for floating point encodings",
+                          "[class][template]",
+                          XORCompressedColumn<float>,
+                          ALPCompressedColumn<float>,
+                          ByteStreamSplitCompressedColumn<float>)
+{
+    // more rows than fit into one block of the block based encodings
+    Column_Test_Fixture<TestType>::reference_data.resize(1000);
+    Column_Test_Fixture<TestType>::test_column_operations();
+}
+
+TEMPLATE_TEST_CASE_METHOD(Column_Test_Fixture,
+                          "Template test case method for string encodings",
+                          "[class][template]",
+                          FSSTCompressedColumn<std::string>)
+{
+    // more rows than the symbol table is trained on
+    Column_Test_Fixture<TestType>::reference_data.resize(1000);
+    Column_Test_Fixture<TestType>::test_column_operations();
+}
+
+TEMPLATE_PRODUCT_TEST_CASE_METHOD(Column_Test_Fixture,
+                                  "Relational operators on compressed columns match the uncompressed column",
+                                  "[class][template][operators]",
+                                  (RLECompressedColumn, DictionaryCompressedColumn, BitVectorCompressedColumn),
+                                  (int, float, std::string))
+{
+    using ValueType = typename Column_Test_Fixture<TestType>::ValueType;
+    auto &col_one = Column_Test_Fixture<TestType>::col_one;
+    auto &reference_data = Column_Test_Fixture<TestType>::reference_data;
+
+    REQUIRE_NOTHROW(fill_column_with_runs<ValueType>(col_one, reference_data));
+    Column<ValueType> reference(getAttributeString<ValueType>());
+    reference.insert(reference_data.begin(), reference_data.end());
+
+    /****** BULK INSERT TEST ******/
+    TestType bulk_loaded(getAttributeString<ValueType>());
+    bulk_loaded.insert(reference_data.begin(), reference_data.end());
+    REQUIRE(bulk_loaded == col_one);
+
+    /****** SORT TEST ******/
+    REQUIRE(col_one.sort(ASCENDING) == reference.sort(ASCENDING));
+    REQUIRE(col_one.sort(DESCENDING) == reference.sort(DESCENDING));
+
+    /****** SELECTION TEST ******/
+    ValueType predicate_value = reference_data[reference_data.size() / 2];
+    for (auto comp : {EQUAL, LESSER, GREATER})
+    {
+        PositionList expected = reference.selection(predicate_value, comp);
+        REQUIRE(col_one.selection(predicate_value, comp) == expected);
+        REQUIRE(col_one.count(predicate_value, comp, 4) == expected.size());
+        REQUIRE(col_one.parallel_selection(predicate_value, comp, 4) == expected);
+    }
+
+    /****** ARITHMETIC TEST ******/
+    if constexpr (!std::is_same_v<ValueType, std::string>)
+    {
+        auto value = get_rand_value<ValueType>();
+        REQUIRE(col_one.add(value));
+        REQUIRE(reference.add(value));
+        REQUIRE_THAT(col_one, isEqual<TestType>(reference.getContent()));
+
+        std::unique_ptr<ColumnBase> summand = col_one.copy();
+        Column<ValueType> reference_summand(reference);
+        REQUIRE(col_one.add(*summand));
+        REQUIRE(reference.add(reference_summand));
+        REQUIRE_THAT(col_one, isEqual<TestType>(reference.getContent()));
+
+        REQUIRE(col_one.minus(reference_summand));
+        REQUIRE(reference.minus(reference_summand));
+        REQUIRE_THAT(col_one, isEqual<TestType>(reference.getContent()));
+
+        REQUIRE(col_one.multiply(ValueType(3)));
+        REQUIRE(reference.multiply(ValueType(3)));
+        REQUIRE_THAT(col_one, isEqual<TestType>(reference.getContent()));
+
+        REQUIRE(col_one.division(ValueType(2)));
+        REQUIRE(reference.division(ValueType(2)));
+        REQUIRE_THAT(col_one, isEqual<TestType>(reference.getContent()));
+        REQUIRE_FALSE(col_one.division(ValueType(0)));
+    }
+
+    /****** JOIN TEST ******/
+    Column<ValueType> probe(getAttributeString<ValueType>());
+    probe.insert(reference_data.begin(), reference_data.begin() + 100);
+    PositionListPair expected_join = reference.nested_loop_join(probe);
+    REQUIRE(col_one.nested_loop_join(probe) == expected_join);
+
+    PositionListPair sort_merge_join = col_one.sort_merge_join(probe, 4);
+    REQUIRE(sort_merge_join.first.size() == expected_join.first.size());
+    for (size_t i = 0; i < sort_merge_join.first.size(); ++i)
+        REQUIRE(col_one[sort_merge_join.first[i]] == probe[sort_merge_join.second[i]]);
+
+    PositionListPair hash_join = col_one.hash_join(probe);
+    REQUIRE(hash_join.first.size() == expected_join.first.size());
+    for (size_t i = 0; i < hash_join.first.size(); ++i)
+        REQUIRE(col_one[hash_join.first[i]] == probe[hash_join.second[i]]);
+}
+
+TEMPLATE_TEST_CASE("Frame-of-reference selections on the packed offsets match the uncompressed column",
+                   "[class][operators]",
+                   FORCompressedColumn<int>,
+                   PatchedFORCompressedColumn<int>)
+{
+    // narrow blocks, narrow blocks with outliers, blocks spanning the whole int range and an uncompressed tail
+    std::vector<int> reference_data(1000);
+    for (size_t i = 0; i < reference_data.size(); ++i)
+        reference_data[i] = i < 512 ? get_rand_value<int>() : static_cast<int>(gen());
+    for (size_t i = 256; i < 384; i += 16)
+        reference_data[i] = 1000000 + static_cast<int>(i);
+    reference_data[600] = std::numeric_limits<int>::min();
+    reference_data[700] = std::numeric_limits<int>::max();
+
+    TestType column("for column");
+    column.insert(reference_data.begin(), reference_data.end());
+    Column<int> reference("reference column");
+    reference.insert(reference_data.begin(), reference_data.end());
+
+    for (int value : {-1, 0, 50, 101, 1000256, reference_data[800], std::numeric_limits<int>::min(), std::numeric_limits<int>::max()})
+    {
+        for (auto comp : {EQUAL, LESSER, GREATER})
+        {
+            PositionList expected = reference.selection(value, comp);
+            REQUIRE(column.selection(value, comp) == expected);
+            REQUIRE(column.count(value, comp) == expected.size());
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE("Floating point encodings evaluate selections like the uncompressed column",
+                   "[class][operators]",
+                   XORCompressedColumn<float>,
+                   ALPCompressedColumn<float>,
+                   ByteStreamSplitCompressedColumn<float>)
+{
+    // a slowly varying series with repeated values, jumps, special values and an uncompressed tail
+    std::vector<float> reference_data(1000);
+    for (size_t i = 0; i < reference_data.size(); ++i)
+        reference_data[i] = i % 7 == 0 ? get_rand_value<float>() : 20.0f + static_cast<float>(i / 3) * 0.25f;
+    reference_data[300] = -0.0f;
+    reference_data[301] = std::numeric_limits<float>::infinity();
+    reference_data[302] = std::numeric_limits<float>::denorm_min();
+    reference_data[303] = -std::numeric_limits<float>::max();
+
+    TestType column("float column");
+    column.insert(reference_data.begin(), reference_data.end());
+    Column<float> reference("reference column");
+    reference.insert(reference_data.begin(), reference_data.end());
+    REQUIRE_THAT(column, isEqual<TestType>(reference_data));
+
+    for (float value : {0.0f, -0.0f, 20.0f, 50.5f, 70.1f, reference_data[500], reference_data[700],
+                        std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity()})
+    {
+        for (auto comp : {EQUAL, LESSER, GREATER})
+        {
+            PositionList expected = reference.selection(value, comp);
+            REQUIRE(column.selection(value, comp) == expected);
+            REQUIRE(column.count(value, comp) == expected.size());
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE("Block encodings update and remove lists of rows across blocks",
+                   "[class][template]",
+                   DeltaCompressedColumn<int>,
+                   FORCompressedColumn<int>,
+                   PatchedFORCompressedColumn<int>,
+                   XORCompressedColumn<float>,
+                   ALPCompressedColumn<float>,
+                   ByteStreamSplitCompressedColumn<float>)
+{
+    using ValueType = typename TestType::value_type;
+    std::vector<ValueType> reference_data(1000);
+    for (auto &value : reference_data)
+        value = get_rand_value<ValueType>();
+
+    TestType column("block column");
+    column.insert(reference_data.begin(), reference_data.end());
+
+    // rows of the same block, of different blocks and of the uncompressed tail
+    PositionList updated{980, 3, 5, 130, 999, 4};
+    column.update(updated, ValueType(42));
+    for (TID tid : updated)
+        reference_data[tid] = ValueType(42);
+    REQUIRE_THAT(column, isEqual<TestType>(reference_data));
+
+    PositionList removed{2, 3, 127, 128, 500, 998, 999};
+    for (auto rit = removed.rbegin(); rit != removed.rend(); ++rit)
+        reference_data.erase(reference_data.begin() + *rit);
+    column.remove(removed);
+    REQUIRE_THAT(column, isEqual<TestType>(reference_data));
+}
+
+TEST_CASE("Symbol table compressed strings evaluate selections like the uncompressed column", "[class][operators]")
+{
+    std::vector<std::string> paths{"index.html", "search?q=", "images/logo.png", "api/v1/users/", ""};
+    std::vector<std::string> reference_data(2000);
+    for (size_t i = 0; i < reference_data.size(); ++i)
+        reference_data[i] = "https://www.example.com/" + paths[i % paths.size()] + std::to_string(i % 97);
+
+    FSSTCompressedColumn<std::string> column("string column");
+    column.insert(reference_data.begin(), reference_data.end());
+    Column<std::string> reference("reference column");
+    reference.insert(reference_data.begin(), reference_data.end());
+
+    REQUIRE_THAT(column, isEqual<FSSTCompressedColumn<std::string>>(reference_data));
+    REQUIRE(column.getSizeInBytes() * 2 < reference_data.size() * reference_data.front().size());
+
+    for (const std::string &value : {reference_data[7], reference_data[1500], std::string("https://"), std::string()})
+    {
+        for (auto comp : {EQUAL, LESSER, GREATER})
+        {
+            PositionList expected = reference.selection(value, comp);
+            REQUIRE(column.selection(value, comp) == expected);
+            REQUIRE(column.count(value, comp) == expected.size());
+        }
+    }
+
+    PositionList removed{0, 3, 4, 1999};
+    for (auto rit = removed.rbegin(); rit != removed.rend(); ++rit)
+        reference_data.erase(reference_data.begin() + *rit);
+    column.remove(removed);
+    REQUIRE_THAT(column, isEqual<FSSTCompressedColumn<std::string>>(reference_data));
+}
+
+TEMPLATE_TEST_CASE("Parallel selections over many morsels return the TIDs in order",
+                   "[class][operators]",
+                   Column<int>,
+                   DictionaryCompressedColumn<int>,
+                   FORCompressedColumn<int>)
+{
+    std::vector<int> values(100000);
+    for (size_t i = 0; i < values.size(); ++i)
+        values[i] = static_cast<int>(i % 1000);
+
+    TestType column("int column");
+    column.insert(values.begin(), values.end());
+
+    for (auto comp : {EQUAL, LESSER, GREATER})
+    {
+        PositionList expected = column.selection(500, comp);
+        for (unsigned int number_of_threads : {1u, 2u, 3u, 8u})
+        {
+            REQUIRE(column.parallel_selection(500, comp, number_of_threads) == expected);
+            REQUIRE(column.ColumnBaseTyped<int>::count(500, comp, number_of_threads) == expected.size());
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE("The SIMD selection kernel returns the TIDs of the scalar comparison", "[class][operators]", int, float)
+{
+    std::vector<TestType> values(1000);
+    for (auto &value : values)
+        value = get_rand_value<TestType>();
+    TestType predicate_value = values[values.size() / 2];
+
+    for (size_t n : {0, 3, 8, 17, 999, 1000})
+    {
+        for (auto comp : {EQUAL, LESSER, GREATER})
+        {
+            PositionList expected;
+            for (size_t i = 0; i < n; ++i)
+            {
+                if ((comp == EQUAL && values[i] == predicate_value) || (comp == LESSER && values[i] < predicate_value) ||
+                    (comp == GREATER && values[i] > predicate_value))
+                    expected.push_back(static_cast<TID>(100 + i));
+            }
+
+            PositionList positions(n);
+            positions.resize(simd::select_positions(values.data(), n, predicate_value, comp, 100, positions.data()));
+            REQUIRE(positions == expected);
+        }
+    }
+}
+
+TEST_CASE("Scans instantiated per comparator reject every row for unknown comparators", "[class][operators]")
+{
+    const auto unknown = static_cast<ValueComparator>(3);
+    REQUIRE_FALSE(with_predicate(unknown, [](auto predicate) { return predicate(1, 1) || predicate(1, 2); }));
+    REQUIRE(with_predicate(LESSER, [](auto predicate) { return predicate(1, 2) && !predicate(2, 1); }));
+
+    Column<int> int_column("int column");
+    Column<std::string> string_column("string column");
+    for (int i = 0; i < 100; ++i)
+    {
+        int_column.insert(i);
+        string_column.insert(std::to_string(i));
+    }
+    REQUIRE(int_column.selection(50, unknown).empty());
+    REQUIRE(string_column.selection(std::string("50"), unknown).empty());
+    REQUIRE(int_column.count(50, unknown, 4) == 0);
+}
+
+TEST_CASE("Sort merge joins return every pair of equal values ordered by value", "[class][operators]")
+{
+    // duplicates on both sides, a shuffled left input and an already sorted right input
+    std::vector<int> left_values(20000), right_values(15000);
+    for (auto &value : left_values)
+        value = get_rand_value<int>();
+    for (size_t i = 0; i < right_values.size(); ++i)
+        right_values[i] = static_cast<int>(i / 150);
+
+    Column<int> left("left"), right("right");
+    left.insert(left_values.begin(), left_values.end());
+    right.insert(right_values.begin(), right_values.end());
+
+    std::vector<std::tuple<int, TID, TID>> expected;
+    for (TID l = 0; l < left_values.size(); ++l)
+    {
+        for (TID r = 0; r < right_values.size(); ++r)
+        {
+            if (left_values[l] == right_values[r])
+                expected.emplace_back(left_values[l], l, r);
+        }
+    }
+    std::sort(expected.begin(), expected.end());
+
+    for (unsigned int number_of_threads : {1u, 2u, 5u})
+    {
+        PositionListPair join_tids = left.sort_merge_join(right, number_of_threads);
+        REQUIRE(join_tids.first.size() == expected.size());
+        bool matches = true;
+        for (size_t i = 0; i < expected.size(); ++i)
+            matches = matches && std::get<1>(expected[i]) == join_tids.first[i] &&
+                      std::get<2>(expected[i]) == join_tids.second[i];
+        REQUIRE(matches);
+    }
+
+    Column<std::string> strings("strings");
+    for (auto const &value : {"b", "a", "c", "a"})
+        strings.insert(std::string(value));
+    PositionListPair self_join = strings.sort_merge_join(strings, 2);
+    REQUIRE(self_join.first == PositionList{1, 1, 3, 3, 0, 2});
+    REQUIRE(self_join.second == PositionList{1, 3, 1, 3, 0, 2});
+}
+
+TEMPLATE_TEST_CASE("Hash joins build on the smaller column and return the pairs of the nested loop join",
+                   "[class][operators]",
+                   int,
+                   float,
+                   std::string)
+{
+    Column<TestType> small("small"), large("large");
+    for (int i = 0; i < 300; ++i)
+        small.insert(get_rand_value<TestType>());
+    for (int i = 0; i < 2000; ++i)
+        large.insert(i % 3 == 0 ? small[i % 300] : get_rand_value<TestType>());
+
+    auto sorted_pairs = [](const PositionListPair &join_tids) {
+        std::vector<std::pair<TID, TID>> pairs;
+        for (size_t i = 0; i < join_tids.first.size(); ++i)
+            pairs.emplace_back(join_tids.first[i], join_tids.second[i]);
+        std::sort(pairs.begin(), pairs.end());
+        return pairs;
+    };
+
+    for (auto [left, right] : {std::pair{&small, &large}, std::pair{&large, &small}})
+    {
+        PositionListPair join_tids = left->hash_join(*right);
+        REQUIRE(!join_tids.first.empty());
+        REQUIRE(sorted_pairs(join_tids) == sorted_pairs(left->nested_loop_join(*right)));
+        // the larger column is probed in TID order
+        const PositionList &probe_tids = left == &small ? join_tids.second : join_tids.first;
+        REQUIRE(std::is_sorted(probe_tids.begin(), probe_tids.end()));
+    }
+}
+
+TEMPLATE_TEST_CASE("Radix partitioned hash joins return the pairs of the hash join",
+                   "[class][operators]",
+                   int,
+                   float,
+                   std::string)
+{
+    auto value_of = [](int i) {
+        if constexpr (std::is_same_v<TestType, std::string>)
+            return std::to_string(i);
+        else
+            return static_cast<TestType>(i);
+    };
+
+    // the smaller column has every value twice and is large enough to be split into several partitions, about half
+    // of the rows of the larger column find a match
+    Column<TestType> small("small"), large("large");
+    for (int i = 0; i < 40000; ++i)
+        small.insert(value_of(i / 2));
+    for (int i = 0; i < 50000; ++i)
+        large.insert(value_of((i * 7) % 40000));
+
+    auto sorted_pairs = [](const PositionListPair &join_tids) {
+        std::vector<std::pair<TID, TID>> pairs;
+        for (size_t i = 0; i < join_tids.first.size(); ++i)
+            pairs.emplace_back(join_tids.first[i], join_tids.second[i]);
+        std::sort(pairs.begin(), pairs.end());
+        return pairs;
+    };
+
+    for (auto [left, right] : {std::pair{&small, &large}, std::pair{&large, &small}})
+    {
+        PositionListPair expected = left->hash_join(*right);
+        REQUIRE(!expected.first.empty());
+        for (unsigned int number_of_threads : {1u, 3u})
+        {
+            REQUIRE(left->parallel_hash_join(*right, number_of_threads) == expected);
+            REQUIRE(sorted_pairs(left->parallel_hash_join(*right, number_of_threads, false)) == sorted_pairs(expected));
+        }
+    }
+}
+
+TEST_CASE("Radix partitioning keeps the rows of every partition in TID order", "[class][operators]")
+{
+    std::vector<int> keys(50000);
+    for (auto &key : keys)
+        key = static_cast<int>(gen());
+
+    // 12 bits take two passes
+    const unsigned bits = 12;
+    auto partitions = radix_partitioning::partition(keys.data(), keys.size(), bits, 3);
+    REQUIRE(partitions.offsets.size() == (size_t(1) << bits) + 1);
+    REQUIRE(partitions.offsets.back() == keys.size());
+
+    bool partitioned = true;
+    std::vector<bool> seen(keys.size(), false);
+    for (size_t p = 0; p + 1 < partitions.offsets.size(); ++p)
+    {
+        for (size_t row = partitions.offsets[p]; row < partitions.offsets[p + 1]; ++row)
+        {
+            TID tid = partitions.tids[row];
+            partitioned = partitioned && !seen[tid] && keys[tid] == partitions.keys[row] &&
+                          radix_partitioning::partition_of(keys[tid], bits) == p &&
+                          (row == partitions.offsets[p] || partitions.tids[row - 1] < tid);
+            seen[tid] = true;
+        }
+    }
+    REQUIRE(partitioned);
+}
+
+TEMPLATE_TEST_CASE("Radix sorts order numeric columns like the comparison sort", "[class][operators]", int, float)
+{
+    // negative and positive values with many duplicates, the extremes of the type and both zeros
+    std::vector<TestType> values(30000);
+    for (size_t i = 0; i < values.size(); ++i)
+        values[i] = static_cast<TestType>(static_cast<int>(gen() % 2001) - 1000) / static_cast<TestType>(i % 2 + 1);
+    values[17] = std::numeric_limits<TestType>::lowest();
+    values[42] = std::numeric_limits<TestType>::max();
+    values[99] = static_cast<TestType>(-0.0);
+    values[100] = static_cast<TestType>(0);
+
+    Column<TestType> column("column");
+    column.insert(values.begin(), values.end());
+
+    std::vector<std::pair<TestType, TID>> pairs;
+    for (TID tid = 0; tid < values.size(); ++tid)
+        pairs.emplace_back(values[tid], tid);
+    for (auto order : {ASCENDING, DESCENDING})
+    {
+        auto expected_pairs = pairs;
+        if (order == ASCENDING)
+            std::stable_sort(expected_pairs.begin(), expected_pairs.end(), std::less_equal<std::pair<TestType, TID>>());
+        else
+            std::stable_sort(expected_pairs.begin(), expected_pairs.end(), std::greater_equal<std::pair<TestType, TID>>());
+        PositionList expected;
+        for (auto &pair : expected_pairs)
+            expected.push_back(pair.second);
+        REQUIRE(column.sort(order) == expected);
+    }
+}
+
+TEST_CASE("Parallel sorts return the TIDs of the sequential sort", "[class][operators]")
+{
+    // few distinct strings, so the chunks share many equal values
+    Column<std::string> strings("strings");
+    for (int i = 0; i < 30000; ++i)
+        strings.insert(std::to_string(gen() % 500));
+
+    for (auto order : {ASCENDING, DESCENDING})
+    {
+        PositionList expected = strings.sort(order);
+        for (unsigned int number_of_threads : {2u, 5u})
+            REQUIRE(strings.sort(order, number_of_threads) == expected);
+    }
+
+    // the multiway merge keeps rows that only compare equal in their input order
+    std::vector<std::pair<int, TID>> rows;
+    for (TID tid = 0; tid < 50000; ++tid)
+        rows.emplace_back(static_cast<int>(gen() % 100), tid);
+    auto by_value = [](const auto &a, const auto &b) { return a.first < b.first; };
+    auto expected = rows;
+    std::stable_sort(expected.begin(), expected.end(), by_value);
+    for (size_t number_of_threads : {3u, 8u})
+    {
+        auto sorted = rows;
+        parallel_sort(sorted.begin(), sorted.end(), by_value, number_of_threads);
+        REQUIRE(sorted == expected);
+    }
+}
+
+TEMPLATE_TEST_CASE("Top-K returns the first k TIDs of the sort",
+                   "[class][operators]",
+                   Column<int>,
+                   Column<std::string>,
+                   DictionaryCompressedColumn<int>,
+                   DictionaryCompressedColumn<std::string>,
+                   RLECompressedColumn<int>,
+                   RLECompressedColumn<float>)
+{
+    using ValueType = typename TestType::value_type;
+    // runs of equal values, and every value occurs in many runs
+    std::vector<ValueType> values(40000);
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        int value = static_cast<int>((i / 7 * 31) % 500);
+        if constexpr (std::is_same_v<ValueType, std::string>)
+            values[i] = std::to_string(value);
+        else
+            values[i] = static_cast<ValueType>(value);
+    }
+
+    TestType column(getAttributeString<ValueType>());
+    column.insert(values.begin(), values.end());
+
+    for (auto order : {ASCENDING, DESCENDING})
+    {
+        PositionList sorted = column.sort(order);
+        for (size_t k : {size_t(0), size_t(1), size_t(100), size_t(1000), values.size(), values.size() + 5})
+        {
+            PositionList expected(sorted.begin(), sorted.begin() + static_cast<std::ptrdiff_t>(std::min(k, sorted.size())));
+            for (unsigned int number_of_threads : {1u, 3u})
+                REQUIRE(column.topK(k, order, number_of_threads) == expected);
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE("Batch decoding returns the same rows as operator[]",
+                   "[class][operators]",
+                   Column<int>,
+                   RLECompressedColumn<int>,
+                   DictionaryCompressedColumn<int>,
+                   DeltaCompressedColumn<int>,
+                   XORCompressedColumn<float>,
+                   ByteStreamSplitCompressedColumn<float>)
+{
+    using ValueType = typename TestType::value_type;
+    std::vector<ValueType> values(5000);
+    for (size_t i = 0; i < values.size(); ++i)
+        values[i] = static_cast<ValueType>((i / 7) % 50);
+
+    TestType column(getAttributeString<ValueType>());
+    column.insert(values.begin(), values.end());
+
+    // ranges that start and end inside blocks, span several blocks and reach into the uncompressed tail
+    for (auto [begin, count] : {std::pair<TID, size_t>{0, 5000}, {0, 1}, {3, 250}, {127, 2}, {1000, 3000}, {4990, 10}})
+    {
+        std::vector<ValueType> decoded(count);
+        column.decode(begin, count, decoded.data());
+        REQUIRE(std::equal(decoded.begin(), decoded.end(), values.begin() + begin));
+    }
+}
+
+TEST_CASE("RLE batch decoding stays correct after the runs change", "[class][operators]")
+{
+    std::vector<int> values(3000);
+    for (size_t i = 0; i < values.size(); ++i)
+        values[i] = static_cast<int>((i / 5) % 20);
+
+    RLECompressedColumn<int> column("rle column");
+    column.insert(values.begin(), values.end());
+
+    std::vector<int> decoded(values.size());
+    auto check = [&]()
+    {
+        decoded.resize(values.size());
+        // continue where the previous call stopped, then jump back
+        column.decode(2000, values.size() - 2000, decoded.data() + 2000);
+        column.decode(0, 2000, decoded.data());
+        REQUIRE(decoded == values);
+    };
+
+    check();
+    column.update(10, ColumnType{99});
+    values[10] = 99;
+    check();
+    column.remove(3);
+    values.erase(values.begin() + 3);
+    check();
+}
+
+TEST_CASE("RLE columns load files written with the pair based run layout", "[class][persistence]")
+{
+    TemporaryDirectory data_directory;
+    std::vector<std::pair<uint8_t, int>> legacy_runs{{3, 7}, {1, 2}, {2, 7}};
+    {
+        std::ofstream outfile(data_directory.path() + "legacy rle column", std::ofstream::binary | std::ofstream::trunc);
+        cereal::PortableBinaryOutputArchive oarchive(outfile);
+        oarchive(legacy_runs);
+    }
+
+    RLECompressedColumn<int> column("legacy rle column");
+    REQUIRE_NOTHROW(column.load(data_directory.path()));
+
+    std::vector<int> reference_data{7, 7, 7, 2, 7, 7};
+    REQUIRE_THAT(column, isEqual<RLECompressedColumn<int>>(reference_data));
+}
+
+TEST_CASE("Columns reject files of an unknown format version", "[class][persistence]")
+{
+    TemporaryDirectory data_directory;
+    auto write_header = [&data_directory](const std::string &name)
+    {
+        std::ofstream outfile(data_directory.path() + name, std::ofstream::binary | std::ofstream::trunc);
+        cereal::PortableBinaryOutputArchive oarchive(outfile);
+        oarchive(uint64_t(UINT64_MAX), uint32_t(2));
+    };
+
+    write_header("newer rle column");
+    RLECompressedColumn<int> rle_column("newer rle column");
+    REQUIRE_THROWS_AS(rle_column.load(data_directory.path()), cereal::Exception);
+
+    write_header("newer float column");
+    Column<float> float_column("newer float column");
+    REQUIRE_THROWS_AS(float_column.load(data_directory.path()), cereal::Exception);
+
+    write_header("newer dictionary column");
+    DictionaryCompressedColumn<std::string> dictionary_column("newer dictionary column");
+    REQUIRE_THROWS_AS(dictionary_column.load(data_directory.path()), cereal::Exception);
+}
+
+TEST_CASE("Boolean columns evaluate selections and logical operators on the bitmap", "[class][operators]")
+{
+    std::vector<bool> reference_data(1000), other_data(1000);
+    for (size_t i = 0; i < reference_data.size(); ++i)
+    {
+        reference_data[i] = get_rand_value<bool>();
+        other_data[i] = get_rand_value<bool>();
+    }
+
+    BooleanCompressedColumn<bool> column("bool column");
+    column.insert(reference_data.begin(), reference_data.end());
+    Column<bool> reference("reference column");
+    reference.insert(reference_data.begin(), reference_data.end());
+    REQUIRE(column.getSizeInBytes() * 8 <= reference_data.size() + 64);
+
+    for (bool value : {false, true})
+    {
+        for (auto comp : {EQUAL, LESSER, GREATER})
+        {
+            PositionList expected = reference.selection(value, comp);
+            REQUIRE(column.selection(value, comp) == expected);
+            REQUIRE(column.count(value, comp) == expected.size());
+        }
+    }
+
+    BooleanCompressedColumn<bool> other("other bool column");
+    other.insert(other_data.begin(), other_data.end());
+    Column<bool> uncompressed_other("uncompressed other bool column");
+    uncompressed_other.insert(other_data.begin(), other_data.end());
+
+    std::vector<bool> expected(reference_data.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+        expected[i] = reference_data[i] && other_data[i];
+    REQUIRE(column.logical_and(other));
+    REQUIRE_THAT(column, isEqual<BooleanCompressedColumn<bool>>(expected));
+
+    for (size_t i = 0; i < expected.size(); ++i)
+        expected[i] = expected[i] || other_data[i];
+    REQUIRE(column.logical_or(uncompressed_other));
+    REQUIRE_THAT(column, isEqual<BooleanCompressedColumn<bool>>(expected));
+
+    expected.flip();
+    column.logical_not();
+    REQUIRE_THAT(column, isEqual<BooleanCompressedColumn<bool>>(expected));
+    REQUIRE(column.count(true, EQUAL) == static_cast<size_t>(std::count(expected.begin(), expected.end(), true)));
+
+    Column<bool> shorter("shorter bool column");
+    REQUIRE_FALSE(column.logical_and(shorter));
+}
+
+TEST_CASE("Dictionary columns store clustered and scattered codes in segments", "[class][operators]")
+{
+    // clustered codes, scattered codes and an uncompressed tail
+    std::vector<int> reference_data(5000);
+    for (size_t i = 0; i < reference_data.size(); ++i)
+        reference_data[i] = i < 2500 ? static_cast<int>(i / 100) : get_rand_value<int>();
+
+    DictionaryCompressedColumn<int> column("dictionary column");
+    column.insert(reference_data.begin(), reference_data.end());
+    Column<int> reference("reference column");
+    reference.insert(reference_data.begin(), reference_data.end());
+    REQUIRE_THAT(column, isEqual<DictionaryCompressedColumn<int>>(reference_data));
+    REQUIRE(column.getSizeInBytes() * 3 < reference_data.size() * sizeof(int));
+
+    for (int value : {0, 7, 24, 50, 101})
+    {
+        for (auto comp : {EQUAL, LESSER, GREATER})
+        {
+            PositionList expected = reference.selection(value, comp);
+            REQUIRE(column.selection(value, comp) == expected);
+            REQUIRE(column.count(value, comp) == expected.size());
+        }
+    }
+
+    column.update(150, 1000);
+    reference_data[150] = 1000;
+    PositionList removed{10, 1024, 1025, 3000, 4999};
+    for (auto rit = removed.rbegin(); rit != removed.rend(); ++rit)
+        reference_data.erase(reference_data.begin() + *rit);
+    column.remove(removed);
+    REQUIRE_THAT(column, isEqual<DictionaryCompressedColumn<int>>(reference_data));
+
+    TemporaryDirectory data_directory;
+    REQUIRE_NOTHROW(column.store(data_directory.path()));
+    DictionaryCompressedColumn<int> loaded("dictionary column");
+    REQUIRE_NOTHROW(loaded.load(data_directory.path()));
+    REQUIRE_THAT(loaded, isEqual<DictionaryCompressedColumn<int>>(reference_data));
+}
+
+TEST_CASE("Dictionary columns update and compute on sealed segments", "[class][operators]")
+{
+    std::vector<int> reference_data(3000);
+    for (size_t i = 0; i < reference_data.size(); ++i)
+        reference_data[i] = static_cast<int>(i % 7 == 0 ? i : i / 50);
+
+    DictionaryCompressedColumn<int> column("dictionary column");
+    column.insert(reference_data.begin(), reference_data.end());
+    Column<int> reference("reference column");
+    reference.insert(reference_data.begin(), reference_data.end());
+
+    // rows in several segments and the uncompressed tail, out of order
+    PositionList positions{2990, 5, 1500, 1023, 6, 2048};
+    column.update(positions, 42);
+    reference.update(positions, 42);
+    REQUIRE_THAT(column, isEqual<DictionaryCompressedColumn<int>>(reference.getContent()));
+
+    // the division merges entries with the same quotient
+    REQUIRE(column.division(10));
+    REQUIRE(reference.division(10));
+    REQUIRE_THAT(column, isEqual<DictionaryCompressedColumn<int>>(reference.getContent()));
+
+    Column<int> summand("summand");
+    summand.insert(reference_data.begin(), reference_data.end());
+    REQUIRE(column.add(summand));
+    REQUIRE(reference.add(summand));
+    REQUIRE_THAT(column, isEqual<DictionaryCompressedColumn<int>>(reference.getContent()));
+
+    REQUIRE(column.multiply(column));
+    REQUIRE(reference.multiply(reference));
+    REQUIRE_THAT(column, isEqual<DictionaryCompressedColumn<int>>(reference.getContent()));
+}
+
+TEST_CASE("Dictionary columns load files written with a single vector of codes", "[class][persistence]")
+{
+    TemporaryDirectory data_directory;
+    std::vector<std::string> dictionary{"a", "b"};
+    std::vector<size_t> codes{1, 0, 0, 1};
+    {
+        std::ofstream outfile(data_directory.path() + "legacy dictionary column", std::ofstream::binary | std::ofstream::trunc);
+        cereal::PortableBinaryOutputArchive oarchive(outfile);
+        oarchive(dictionary, codes);
+    }
+
+    DictionaryCompressedColumn<std::string> column("legacy dictionary column");
+    REQUIRE_NOTHROW(column.load(data_directory.path()));
+
+    std::vector<std::string> reference_data{"b", "a", "a", "b"};
+    REQUIRE_THAT(column, isEqual<DictionaryCompressedColumn<std::string>>(reference_data));
+}
+
+TEST_CASE("Float columns load files written as a plain vector of floats", "[class][persistence]")
+{
+    TemporaryDirectory data_directory;
+    std::vector<float> reference_data{1.5f, -0.0f, 3.25f, std::numeric_limits<float>::max()};
+    {
+        std::ofstream outfile(data_directory.path() + "legacy float column", std::ofstream::binary | std::ofstream::trunc);
+        cereal::PortableBinaryOutputArchive oarchive(outfile);
+        oarchive(reference_data);
+    }
+
+    Column<float> column("legacy float column");
+    REQUIRE_NOTHROW(column.load(data_directory.path()));
+    REQUIRE_THAT(column, isEqual<Column<float>>(reference_data));
+}
+
+TEMPLATE_TEST_CASE("RLE arithmetic with other encodings spans several vectors",
+                   "[class][operators]",
+                   Column<float>,
+                   XORCompressedColumn<float>,
+                   ByteStreamSplitCompressedColumn<float>)
+{
+    std::vector<float> reference_data(5000), other_data(5000);
+    for (size_t i = 0; i < reference_data.size(); ++i)
+    {
+        reference_data[i] = static_cast<float>(i / 30);
+        other_data[i] = static_cast<float>(i % 300 < 150 ? 1 : i % 7);
+    }
+
+    RLECompressedColumn<float> column("rle column");
+    column.insert(reference_data.begin(), reference_data.end());
+    Column<float> reference("reference column");
+    reference.insert(reference_data.begin(), reference_data.end());
+    TestType other("other column");
+    other.insert(other_data.begin(), other_data.end());
+
+    REQUIRE(column.add(other));
+    REQUIRE(reference.add(other));
+    REQUIRE_THAT(column, isEqual<RLECompressedColumn<float>>(reference.getContent()));
+
+    REQUIRE(column.multiply(other));
+    REQUIRE(reference.multiply(other));
+    REQUIRE_THAT(column, isEqual<RLECompressedColumn<float>>(reference.getContent()));
+}
+
+TEST_CASE("RLE bulk loading encodes long inputs like row wise inserts", "[class][insert]")
+{
+    std::vector<int> reference_data(140000);
+    for (size_t i = 0; i < reference_data.size(); ++i)
+        reference_data[i] = i < 70000 ? static_cast<int>(i / 97) : static_cast<int>(i / 1000);
+
+    RLECompressedColumn<int> bulk_loaded("bulk loaded column");
+    bulk_loaded.insert(reference_data[0]);
+    bulk_loaded.insert(reference_data.begin() + 1, reference_data.end(), 4);
+
+    RLECompressedColumn<int> row_wise("row wise column");
+    for (int value : reference_data)
+        row_wise.insert(value);
+
+    REQUIRE(bulk_loaded.getSizeInBytes() == row_wise.getSizeInBytes());
+    REQUIRE_THAT(bulk_loaded, isEqual<RLECompressedColumn<int>>(reference_data));
+}
@@ -13,6 +13,7 @@
 #include <core/column.hpp>
 #include <core/column_base_typed.hpp>
 #include <core/global_definitions.hpp>
+#include <filesystem>
 #include <random>
 #include <string>
 
@@ -48,11 +49,58 @@ std::string get_rand_value() {
     return s;
 }
 
+template<>
+bool get_rand_value() {
+    auto dist = std::bernoulli_distribution(0.5);
+    return dist(gen);
+}
+
+// a new directory below the temporary directory of the system, which is removed with all files in it at the end of
+// the scope, so that tests can store columns without leaving files behind
+class TemporaryDirectory {
+public:
+    TemporaryDirectory() {
+        std::random_device random;
+        do {
+            directory = std::filesystem::temp_directory_path() / ("cogadb_test_" + std::to_string(random()));
+        } while (!std::filesystem::create_directory(directory));
+    }
+
+    TemporaryDirectory(const TemporaryDirectory &) = delete;
+    TemporaryDirectory &operator=(const TemporaryDirectory &) = delete;
+
+    ~TemporaryDirectory() {
+        std::error_code error;
+        std::filesystem::remove_all(directory, error);
+    }
+
+    // the path with a trailing separator, columns append their name to it
+    [[nodiscard]] std::string path() const {
+        return (directory / "").string();
+    }
+
+private:
+    std::filesystem::path directory;
+};
+
 template<class T>
 void fill_column(ColumnBaseTyped<T> &col, std::vector<T> &reference_data) {
     for (unsigned int i = 0; i < reference_data.size(); i++) {
-        reference_data[i] = get_rand_value<T>();
-        col.insert(reference_data[i]);
+        T value = get_rand_value<T>();
+        reference_data[i] = value;
+        col.insert(value);
+    }
+}
+
+template<class T>
+void fill_column_with_runs(ColumnBaseTyped<T> &col, std::vector<T> &reference_data) {
+    auto run_length = std::uniform_int_distribution(1, 8);
+    for (unsigned int i = 0; i < reference_data.size();) {
+        T value = get_rand_value<T>();
+        for (int n = run_length(gen); n > 0 && i < reference_data.size(); --n, ++i) {
+            reference_data[i] = value;
+            col.insert(value);
+        }
     }
 }
 
@@ -117,6 +165,11 @@ AttributeType getAttributeType<std::string>() {
     return VARCHAR;
 }
 
+template<>
+AttributeType getAttributeType<bool>() {
+    return BOOLEAN;
+}
+
 template<typename ValueType>
 std::string getAttributeString() {
     return "unknown column";
@@ -134,4 +187,9 @@ std::string getAttributeString<float>() {
 template<>
 std::string getAttributeString<std::string>() {
     return "string column";
+}
+
+template<>
+std::string getAttributeString<bool>() {
+    return "bool column";
 }
\ No newline at end of file